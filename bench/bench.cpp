@@ -0,0 +1,336 @@
+/*
+**	Author: zerico2005 (2025)
+**	Project: 
+**	License: MIT License
+**	A copy of the MIT License should be included with
+**	this project. If not, see https://opensource.org/license/MIT
+*/
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "options.h"
+#include "random_gen.h"
+#include "stratified_sampler.h"
+#include "table_writer.h"
+#include "test_list.h"
+
+/*
+** Times each stage of table generation in isolation, for every table and
+** both float types:
+**   random_gen_basic       filling random finite values
+**   random_gen_stratified  the same, stratified by sign and exponent
+**   edge_rows              generate_input over the leading (edge case) rows
+**   generate_input         generate_input over every row
+**   evaluate               the evaluator used by the generator
+**   evaluate_scalar        the scalar reference of batched evaluators
+**   format                 formatting the records as text
+**   write                  writing the header table file
+*/
+
+/*
+** Fills values[i] with uniformly random finite values, rejecting the
+** non-finite draws. The sampler the tables used before
+** random_gen_stratified, kept as its baseline.
+*/
+template <typename T>
+void random_gen_basic(
+	std::span<float_bits<T>> values, const Random_Stream& rng, uint64_t first_index
+) {
+	for (size_t i = 0; i < values.size(); i++) {
+		for (uint32_t attempt = 0;; attempt++) {
+			float_bits<T> temp = static_cast<float_bits<T>>(rng.bits(first_index + i, attempt));
+			if (std::isfinite(std::bit_cast<T>(temp))) {
+				values[i] = temp;
+				break;
+			}
+		}
+	}
+}
+
+struct Bench_Options {
+	size_t rows = 65536;
+	/* each stage is repeated for at least this long */
+	double min_seconds = 0.05;
+	const char* json_file = nullptr;
+	const char* baseline_file = nullptr;
+	/* slowdown beyond which a stage is reported as a regression */
+	double threshold = 0.10;
+};
+
+struct Bench_Result {
+	std::string type;
+	std::string table;
+	std::string stage;
+	double ns_per_element;
+	double bytes_per_second;
+};
+
+/* @returns the fastest time of one call, in seconds */
+template<typename Function>
+double time_stage(const Bench_Options& options, Function function) {
+	using clock = std::chrono::steady_clock;
+	double best = 1.0e300;
+	double total = 0.0;
+	for (int run = 0; run < 3 || total < options.min_seconds; run++) {
+		clock::time_point start = clock::now();
+		function();
+		double seconds = std::chrono::duration<double>(clock::now() - start).count();
+		best = std::min(best, seconds);
+		total += seconds;
+	}
+	return best;
+}
+
+template<typename T>
+void add_result(
+	std::vector<Bench_Result>& results, const std::string& table, const char* stage,
+	double seconds, size_t elements, size_t bytes
+) {
+	results.push_back({
+		float_name<T>::fX, table, stage,
+		seconds * 1.0e9 / static_cast<double>(std::max<size_t>(elements, 1)),
+		static_cast<double>(bytes) / seconds
+	});
+}
+
+template<typename T>
+void bench_tables(
+	const Bench_Options& options, const std::filesystem::path& directory,
+	std::vector<Bench_Result>& results
+) {
+	const size_t rows = options.rows;
+	{
+		std::vector<float_bits<T>> values(rows);
+		const Random_Stream rng = {0, stream_value};
+		double seconds = time_stage(options, [&] {
+			random_gen_basic<T>(values, rng, 0);
+		});
+		add_result<T>(results, "all", "random_gen_basic", seconds, rows, rows * sizeof(T));
+		seconds = time_stage(options, [&] {
+			random_gen_stratified<T>(values, rng, 0);
+		});
+		add_result<T>(results, "all", "random_gen_stratified", seconds, rows, rows * sizeof(T));
+	}
+
+	for (const Test_Gen<T>& table : get_test_list<T>()) {
+		Record_Columns input(table.input_layout, rows);
+		Record_Columns output(table.output_layout, rows);
+		const size_t input_bytes = rows * table.input_layout.record_size();
+		const size_t output_bytes = rows * table.output_layout.record_size();
+		const Gen_Slice slice = {0, rows, 0, 0, rows};
+		double seconds;
+
+		const size_t edge_rows = std::min(rows, edge_cases<T>.size());
+		const Gen_Slice edge_slice = {0, rows, 0, 0, edge_rows};
+		seconds = time_stage(options, [&] { table.generate_input(edge_slice, input); });
+		add_result<T>(
+			results, table.table_name, "edge_rows", seconds,
+			edge_rows, edge_rows * table.input_layout.record_size()
+		);
+
+		seconds = time_stage(options, [&] { table.generate_input(slice, input); });
+		add_result<T>(results, table.table_name, "generate_input", seconds, rows, input_bytes);
+
+		seconds = time_stage(options, [&] { table.evaluate(input, output, 0, rows); });
+		add_result<T>(results, table.table_name, "evaluate", seconds, rows, output_bytes);
+
+		if (table.reference != nullptr) {
+			Record_Columns expected(table.output_layout, rows);
+			seconds = time_stage(options, [&] { table.reference(input, expected, 0, rows); });
+			add_result<T>(results, table.table_name, "evaluate_scalar", seconds, rows, output_bytes);
+		}
+
+		std::vector<char> text(records_text_length(input) + records_text_length(output));
+		seconds = time_stage(options, [&] {
+			write_records_text(write_records_text(text.data(), input), output);
+		});
+		add_result<T>(results, table.table_name, "format", seconds, rows, text.size());
+
+		const std::string file_name = (directory / table_file_name(table)).string();
+		seconds = time_stage(options, [&] {
+			write_header_table(table, file_name, input, output, nullptr, 0);
+		});
+		std::error_code error;
+		size_t file_size = static_cast<size_t>(std::filesystem::file_size(file_name, error));
+		add_result<T>(results, table.table_name, "write", seconds, rows, error ? 0 : file_size);
+		std::filesystem::remove(file_name, error);
+	}
+}
+
+inline std::string result_key(const std::string& type, const std::string& table, const std::string& stage) {
+	return type + " " + table + " " + stage;
+}
+
+/* one result per line, so that a baseline can be read back with sscanf */
+bool write_json(const char* file_name, const std::vector<Bench_Result>& results) {
+	FILE* file = fopen(file_name, "wb");
+	if (file == nullptr) {
+		printf("Unable to open file \"%s\"\n", file_name);
+		return false;
+	}
+	fprintf(file, "[\n");
+	for (size_t i = 0; i < results.size(); i++) {
+		const Bench_Result& result = results[i];
+		fprintf(
+			file,
+			"{\"type\": \"%s\", \"table\": \"%s\", \"stage\": \"%s\", "
+			"\"ns_per_element\": %.6g, \"bytes_per_second\": %.6g}%s\n",
+			result.type.c_str(), result.table.c_str(), result.stage.c_str(),
+			result.ns_per_element, result.bytes_per_second,
+			(i + 1 < results.size()) ? "," : ""
+		);
+	}
+	fprintf(file, "]\n");
+	fclose(file);
+	return true;
+}
+
+bool read_baseline(const char* file_name, std::map<std::string, double>& baseline) {
+	FILE* file = fopen(file_name, "rb");
+	if (file == nullptr) {
+		printf("Unable to open file \"%s\"\n", file_name);
+		return false;
+	}
+	char line[512];
+	while (fgets(line, sizeof(line), file) != nullptr) {
+		char type[16];
+		char table[128];
+		char stage[64];
+		double ns_per_element;
+		if (sscanf(
+			line, " {\"type\": \"%15[^\"]\", \"table\": \"%127[^\"]\", \"stage\": \"%63[^\"]\", "
+			"\"ns_per_element\": %lf",
+			type, table, stage, &ns_per_element
+		) == 4) {
+			baseline[result_key(type, table, stage)] = ns_per_element;
+		}
+	}
+	fclose(file);
+	return true;
+}
+
+/* @returns the number of stages slower than the baseline by more than the threshold */
+size_t compare_baseline(
+	const Bench_Options& options, const std::vector<Bench_Result>& results,
+	const std::map<std::string, double>& baseline
+) {
+	size_t regressions = 0;
+	for (const Bench_Result& result : results) {
+		auto iter = baseline.find(result_key(result.type, result.table, result.stage));
+		if (iter == baseline.end() || iter->second <= 0.0) {
+			continue;
+		}
+		double change = result.ns_per_element / iter->second - 1.0;
+		if (change > options.threshold) {
+			printf(
+				"Regression %s %s %s: %.3f -> %.3f ns/element (%+.1f%%)\n",
+				result.type.c_str(), result.table.c_str(), result.stage.c_str(),
+				iter->second, result.ns_per_element, 100.0 * change
+			);
+			regressions++;
+		}
+	}
+	return regressions;
+}
+
+void print_bench_usage(const char* program) {
+	printf(
+		"Usage: %s [options]\n"
+		"  --rows <N>          rows per table (default: 65536)\n"
+		"  --min-time <ms>     minimum time spent on each stage (default: 50)\n"
+		"  --json <file>       write the results as JSON\n"
+		"  --baseline <file>   compare against a JSON file written by --json\n"
+		"  --threshold <pct>   slowdown reported as a regression (default: 10)\n"
+		"  -h, --help          show this message\n",
+		program
+	);
+}
+
+int main(int argc, char* argv[]) {
+	Bench_Options options;
+	for (int i = 1; i < argc; i++) {
+		const char* arg = argv[i];
+		const char* next = (i + 1 < argc) ? argv[i + 1] : nullptr;
+		size_t value;
+		if (strcmp(arg, "-h") == 0 || strcmp(arg, "--help") == 0) {
+			print_bench_usage(argv[0]);
+			return 0;
+		} else if (strcmp(arg, "--rows") == 0) {
+			if (!parse_size_option(arg, next, max_count, options.rows) || options.rows == 0) {
+				return 1;
+			}
+			i++;
+		} else if (strcmp(arg, "--min-time") == 0) {
+			if (!parse_size_option(arg, next, UINT32_MAX, value)) {
+				return 1;
+			}
+			options.min_seconds = static_cast<double>(value) / 1000.0;
+			i++;
+		} else if (strcmp(arg, "--threshold") == 0) {
+			if (!parse_size_option(arg, next, UINT32_MAX, value)) {
+				return 1;
+			}
+			options.threshold = static_cast<double>(value) / 100.0;
+			i++;
+		} else if (strcmp(arg, "--json") == 0 && next != nullptr) {
+			options.json_file = next;
+			i++;
+		} else if (strcmp(arg, "--baseline") == 0 && next != nullptr) {
+			options.baseline_file = next;
+			i++;
+		} else {
+			printf("Error: unknown option \"%s\"\n", arg);
+			print_bench_usage(argv[0]);
+			return 1;
+		}
+	}
+
+	std::error_code error;
+	const std::filesystem::path directory = std::filesystem::temp_directory_path() / "test_gen_bench";
+	std::filesystem::create_directories(directory, error);
+	if (error) {
+		printf("Unable to create directory \"%s\"\n", directory.string().c_str());
+		return 1;
+	}
+
+	std::vector<Bench_Result> results;
+	bench_tables<float>(options, directory, results);
+	bench_tables<double>(options, directory, results);
+
+	printf("%-4s %-18s %-21s %12s %12s\n", "type", "table", "stage", "ns/element", "MB/s");
+	for (const Bench_Result& result : results) {
+		printf(
+			"%-4s %-18s %-21s %12.3f %12.1f\n",
+			result.type.c_str(), result.table.c_str(), result.stage.c_str(),
+			result.ns_per_element, result.bytes_per_second / 1.0e6
+		);
+	}
+
+	if (options.json_file != nullptr && !write_json(options.json_file, results)) {
+		return 1;
+	}
+	if (options.baseline_file != nullptr) {
+		std::map<std::string, double> baseline;
+		if (!read_baseline(options.baseline_file, baseline)) {
+			return 1;
+		}
+		if (compare_baseline(options, results, baseline) != 0) {
+			return 1;
+		}
+		printf("No regressions against \"%s\"\n", options.baseline_file);
+	}
+	return 0;
+}
@@ -0,0 +1,465 @@
+#ifndef BINARY_EXPORT_H
+#define BINARY_EXPORT_H
+
+#include <algorithm>
+#include <bit>
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "table_cache.hpp"
+#include "table_columns.hpp"
+#include "table_writer.h"
+
+/*
+** Binary tables are a fixed little endian header followed by the input and
+** output records, laid out exactly like the C structs of the header format
+** so that a memory mapped file can be used as typed arrays directly.
+**
+**   0  char     magic[8]            "TGLUTBIN"
+**   8  uint32_t version
+**  12  uint32_t float_bits          width of T in bits
+**  16  uint32_t input_fields
+**  20  uint32_t output_fields
+**  24  uint32_t input_record_size
+**  28  uint32_t output_record_size
+**  32  uint64_t count
+**  40  uint64_t seed
+**  48  uint64_t input_offset        64 byte aligned
+**  56  uint64_t output_offset       64 byte aligned
+**  64  uint64_t checksum            hash of the input and output records
+**  72  uint64_t reserved
+**  80  field descriptors            input fields, then output fields
+**
+** Each field descriptor is 8 bytes:
+**   uint8_t kind, uint8_t size, uint16_t offset, uint32_t reserved
+**
+** ilogb/frexp exponents of zero, infinity, and NaN are stored as the
+** FP_ILOGB0, INT_MAX, and FP_ILOGBNAN of the generating host.
+*/
+
+constexpr char binary_magic[8] = {'T', 'G', 'L', 'U', 'T', 'B', 'I', 'N'};
+constexpr uint32_t binary_format_version = 1;
+constexpr size_t binary_header_size = 80;
+constexpr size_t binary_field_descriptor_size = 8;
+constexpr size_t binary_alignment = 64;
+
+constexpr const char* binary_loader_file_name = "test_gen_bin.h";
+
+inline size_t align_up(size_t value, size_t alignment) {
+	return (value + alignment - 1) / alignment * alignment;
+}
+
+inline void store_le(unsigned char* dst, uint64_t value, size_t size) {
+	for (size_t i = 0; i < size; i++) {
+		dst[i] = static_cast<unsigned char>(value >> (8 * i));
+	}
+}
+
+inline int32_t binary_expon_value(int64_t expon) {
+	switch (expon) {
+		case expon_int_max: return INT_MAX;
+		case expon_ilogbnan: return FP_ILOGBNAN;
+		case expon_ilogb0: return FP_ILOGB0;
+		default: return static_cast<int32_t>(expon);
+	}
+}
+
+template<typename Stored, typename U>
+inline void pack_column(unsigned char* dst, size_t stride, std::span<const U> values) {
+	for (size_t i = 0; i < values.size(); i++) {
+		Stored value = static_cast<Stored>(values[i]);
+		if constexpr (std::endian::native == std::endian::little) {
+			std::memcpy(dst + i * stride, &value, sizeof(value));
+		} else {
+			store_le(dst + i * stride, static_cast<uint64_t>(value), sizeof(value));
+		}
+	}
+}
+
+/* packs column-wise records into C struct layout */
+inline void pack_records(unsigned char* dst, const Record_Layout& layout, const Record_Columns& records) {
+	const size_t record_size = layout.record_size();
+	std::memset(dst, 0, record_size * records.size());
+	for (size_t c = 0; c < layout.size(); c++) {
+		unsigned char* field = dst + layout.field_offset(c);
+		const Column& column = records[c];
+		if (column.field.kind == Field_Kind::expon) {
+			std::span<const uint64_t> values = column.values<uint64_t>();
+			for (size_t i = 0; i < values.size(); i++) {
+				int32_t expon = binary_expon_value(static_cast<int64_t>(values[i]));
+				store_le(field + i * record_size, static_cast<uint32_t>(expon), 4);
+			}
+		} else if (!field_is_wide(column.field.kind)) {
+			pack_column<uint32_t>(field, record_size, column.values<uint32_t>());
+		} else {
+			pack_column<uint64_t>(field, record_size, column.values<uint64_t>());
+		}
+	}
+}
+
+inline void write_field_descriptors(unsigned char* dst, const Record_Layout& layout) {
+	for (size_t c = 0; c < layout.size(); c++) {
+		unsigned char* desc = dst + c * binary_field_descriptor_size;
+		std::memset(desc, 0, binary_field_descriptor_size);
+		desc[0] = static_cast<unsigned char>(layout.fields[c].kind);
+		desc[1] = static_cast<unsigned char>(field_size(layout.fields[c].kind));
+		store_le(desc + 2, layout.field_offset(c), 2);
+	}
+}
+
+/* field descriptors as a C initializer, for the generated loader */
+inline std::string field_descriptors_initializer(const Record_Layout& input, const Record_Layout& output) {
+	std::string ret;
+	for (const Record_Layout* layout : {&input, &output}) {
+		std::vector<unsigned char> desc(layout->size() * binary_field_descriptor_size);
+		write_field_descriptors(desc.data(), *layout);
+		for (size_t b = 0; b < desc.size(); b++) {
+			ret += (b % binary_field_descriptor_size == 0) ? "\t\t" : " ";
+			ret += std::to_string(desc[b]) + ",";
+			ret += ((b + 1) % binary_field_descriptor_size == 0) ? "\n" : "";
+		}
+	}
+	return ret;
+}
+
+struct Binary_Table {
+	/* such as f32_sqrt_LUT */
+	std::string prefix;
+	uint32_t float_bits;
+	uint64_t seed;
+	std::string timestamp;
+	const Record_Layout& input_layout;
+	const Record_Layout& output_layout;
+	const Record_Columns& input;
+	const Record_Columns& output;
+};
+
+inline Write_Status export_binary_table(
+	const Binary_Table& table, Table_Cache* cache, uint64_t key
+) {
+	const std::string file_name = table.prefix + ".bin";
+	const size_t count = table.input.size();
+	const size_t field_count = table.input_layout.size() + table.output_layout.size();
+	const size_t input_size = table.input_layout.record_size();
+	const size_t output_size = table.output_layout.record_size();
+	const size_t input_offset = align_up(
+		binary_header_size + field_count * binary_field_descriptor_size, binary_alignment
+	);
+	const size_t output_offset = align_up(input_offset + count * input_size, binary_alignment);
+	const size_t file_size = output_offset + count * output_size;
+
+	return write_cached_file(
+		cache, file_name, key, table.timestamp, file_size, 0, 0,
+		[&](char* dst) {
+			unsigned char* file = reinterpret_cast<unsigned char*>(dst);
+			std::memset(file, 0, output_offset);
+			pack_records(file + input_offset, table.input_layout, table.input);
+			pack_records(file + output_offset, table.output_layout, table.output);
+			uint64_t checksum = hash_bytes(file + input_offset, count * input_size);
+			checksum = hash_bytes(file + output_offset, count * output_size, checksum);
+
+			std::memcpy(file, binary_magic, sizeof(binary_magic));
+			store_le(file + 8, binary_format_version, 4);
+			store_le(file + 12, table.float_bits, 4);
+			store_le(file + 16, table.input_layout.size(), 4);
+			store_le(file + 20, table.output_layout.size(), 4);
+			store_le(file + 24, input_size, 4);
+			store_le(file + 28, output_size, 4);
+			store_le(file + 32, count, 8);
+			store_le(file + 40, table.seed, 8);
+			store_le(file + 48, input_offset, 8);
+			store_le(file + 56, output_offset, 8);
+			store_le(file + 64, checksum, 8);
+			write_field_descriptors(file + binary_header_size, table.input_layout);
+			write_field_descriptors(
+				file + binary_header_size + table.input_layout.size() * binary_field_descriptor_size,
+				table.output_layout
+			);
+		}
+	);
+}
+
+/* writes a C struct declaration for a record layout */
+inline std::string binary_record_typedef(const Record_Layout& layout, const std::string& name) {
+	return "typedef " + layout.c_type() + " " + name + ";\n" +
+		"TEST_GEN_BIN_STATIC_ASSERT(sizeof(" + name + ") == " +
+		std::to_string(layout.record_size()) + ", " + name + "_size);\n";
+}
+
+/* per table loader, such as f32_sqrt_LUT_bin.h */
+inline Write_Status export_binary_loader(
+	const Binary_Table& table, const std::string& headers, Table_Cache* cache, uint64_t key
+) {
+	const std::string& p = table.prefix;
+	const std::string file_name = p + "_bin.h";
+	std::string guard = file_name;
+	std::transform(guard.begin(), guard.end(), guard.begin(), ::toupper);
+	std::replace(guard.begin(), guard.end(), '.', '_');
+
+	std::string text;
+	text += "#ifndef " + guard + "\n";
+	text += "#define " + guard + "\n\n";
+	text += headers + "\n";
+	text += "#include \"" + std::string(binary_loader_file_name) + "\"\n\n";
+	text += "/* memory maps " + p + ".bin */\n\n";
+	text += binary_record_typedef(table.input_layout, p + "_input_type") + "\n";
+	text += binary_record_typedef(table.output_layout, p + "_output_type") + "\n";
+	text += "typedef struct {\n";
+	text += "\tconst " + p + "_input_type* input;\n";
+	text += "\tconst " + p + "_output_type* output;\n";
+	text += "\tsize_t count;\n";
+	text += "\tuint64_t seed;\n";
+	text += "\ttest_gen_bin_file file;\n";
+	text += "} " + p + "_view;\n\n";
+	text += "/* @returns 0 on success */\n";
+	text += "static inline int " + p + "_load(const char* path, " + p + "_view* view) {\n";
+	text += "\tstatic const unsigned char fields[] = {\n";
+	text += field_descriptors_initializer(table.input_layout, table.output_layout);
+	text += "\t};\n";
+	text += "\tif (test_gen_bin_open(\n";
+	text += "\t\tpath, " + std::to_string(table.float_bits) + ", fields, " +
+		std::to_string(table.input_layout.size()) + ", " +
+		std::to_string(table.output_layout.size()) + ", sizeof(" + p + "_input_type), sizeof(" +
+		p + "_output_type), &view->file\n";
+	text += "\t) != 0) {\n";
+	text += "\t\treturn -1;\n";
+	text += "\t}\n";
+	text += "\tview->input = (const " + p + "_input_type*)view->file.input;\n";
+	text += "\tview->output = (const " + p + "_output_type*)view->file.output;\n";
+	text += "\tview->count = (size_t)view->file.count;\n";
+	text += "\tview->seed = view->file.seed;\n";
+	text += "\treturn 0;\n";
+	text += "}\n\n";
+	text += "static inline void " + p + "_unload(" + p + "_view* view) {\n";
+	text += "\ttest_gen_bin_close(&view->file);\n";
+	text += "}\n\n";
+	text += "#if defined(__cplusplus) && __cplusplus >= 202002L\n";
+	text += "#include <span>\n";
+	text += "inline std::span<const " + p + "_input_type> " + p + "_inputs(const " + p + "_view& view) {\n";
+	text += "\treturn {view.input, view.count};\n";
+	text += "}\n";
+	text += "inline std::span<const " + p + "_output_type> " + p + "_outputs(const " + p + "_view& view) {\n";
+	text += "\treturn {view.output, view.count};\n";
+	text += "}\n";
+	text += "#endif\n\n";
+	text += "#endif /* " + guard + " */\n";
+
+	return write_cached_file(
+		cache, file_name, key, table.timestamp, text.size(), 0, 0,
+		[&](char* dst) {
+			std::memcpy(dst, text.data(), text.size());
+		}
+	);
+}
+
+/* shared by every per table loader */
+inline const char* binary_loader_source() {
+	return
+R"(#ifndef TEST_GEN_BIN_H
+#define TEST_GEN_BIN_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if !defined(_WIN32)
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+#ifdef __cplusplus
+	#define TEST_GEN_BIN_STATIC_ASSERT(cond, name) static_assert(cond, #name)
+#else
+	#define TEST_GEN_BIN_STATIC_ASSERT(cond, name) _Static_assert(cond, #name)
+#endif
+
+#define TEST_GEN_BIN_VERSION 1
+#define TEST_GEN_BIN_HEADER_SIZE 80
+#define TEST_GEN_BIN_FIELD_SIZE 8
+
+typedef struct {
+	const void* input;
+	const void* output;
+	uint64_t count;
+	uint64_t seed;
+	uint64_t checksum;
+	uint32_t input_size;
+	uint32_t output_size;
+	void* data;
+	size_t size;
+} test_gen_bin_file;
+
+static inline uint32_t test_gen_bin_u32(const unsigned char* p) {
+	return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline uint64_t test_gen_bin_u64(const unsigned char* p) {
+	return (uint64_t)test_gen_bin_u32(p) | ((uint64_t)test_gen_bin_u32(p + 4) << 32);
+}
+
+static inline uint64_t test_gen_bin_rotl(uint64_t x, int n) {
+	return (x << n) | (x >> (64 - n));
+}
+
+/* the checksum used by the generator */
+static inline uint64_t test_gen_bin_hash(const void* data, size_t size, uint64_t hash) {
+	const uint64_t prime = UINT64_C(0x9E3779B97F4A7C15);
+	const unsigned char* ptr = (const unsigned char*)data;
+	uint64_t word;
+	hash ^= (uint64_t)size * prime;
+	for (; size >= 8; size -= 8, ptr += 8) {
+		memcpy(&word, ptr, 8);
+		hash = (test_gen_bin_rotl(hash, 29) ^ word) * prime;
+	}
+	word = 0;
+	memcpy(&word, ptr, size);
+	hash = (test_gen_bin_rotl(hash, 29) ^ word) * prime;
+	hash ^= hash >> 32;
+	hash *= prime;
+	return hash ^ (hash >> 29);
+}
+
+/* whether count records of record_size bytes at offset lie within size bytes, without overflow */
+static inline int test_gen_bin_fits(
+	uint64_t offset, uint64_t count, uint64_t record_size, uint64_t size
+) {
+	return offset <= size && (record_size == 0 || count <= (size - offset) / record_size);
+}
+
+static inline void test_gen_bin_close(test_gen_bin_file* file) {
+	if (file->data == NULL) {
+		return;
+	}
+	#if !defined(_WIN32)
+		munmap(file->data, file->size);
+	#else
+		free(file->data);
+	#endif
+	file->data = NULL;
+}
+
+/*
+** Maps a table and checks that its layout matches the expected field
+** descriptors. @returns 0 on success
+*/
+static inline int test_gen_bin_open(
+	const char* path, uint32_t float_bits, const unsigned char* fields,
+	uint32_t input_fields, uint32_t output_fields,
+	size_t input_size, size_t output_size, test_gen_bin_file* file
+) {
+	const unsigned char* head;
+	uint64_t input_offset, output_offset;
+	memset(file, 0, sizeof(*file));
+	#if !defined(_WIN32)
+	{
+		struct stat info;
+		int fd = open(path, O_RDONLY);
+		if (fd < 0) {
+			return -1;
+		}
+		if (fstat(fd, &info) != 0 || info.st_size < TEST_GEN_BIN_HEADER_SIZE) {
+			close(fd);
+			return -1;
+		}
+		file->size = (size_t)info.st_size;
+		file->data = mmap(NULL, file->size, PROT_READ, MAP_PRIVATE, fd, 0);
+		close(fd);
+		if (file->data == MAP_FAILED) {
+			file->data = NULL;
+			return -1;
+		}
+	}
+	#else
+	{
+		long size;
+		FILE* fp = fopen(path, "rb");
+		if (fp == NULL) {
+			return -1;
+		}
+		fseek(fp, 0, SEEK_END);
+		size = ftell(fp);
+		fseek(fp, 0, SEEK_SET);
+		if (size < TEST_GEN_BIN_HEADER_SIZE) {
+			fclose(fp);
+			return -1;
+		}
+		file->size = (size_t)size;
+		file->data = malloc(file->size);
+		if (file->data == NULL || fread(file->data, 1, file->size, fp) != file->size) {
+			fclose(fp);
+			test_gen_bin_close(file);
+			return -1;
+		}
+		fclose(fp);
+	}
+	#endif
+	head = (const unsigned char*)file->data;
+	input_offset = test_gen_bin_u64(head + 48);
+	output_offset = test_gen_bin_u64(head + 56);
+	file->count = test_gen_bin_u64(head + 32);
+	file->seed = test_gen_bin_u64(head + 40);
+	file->checksum = test_gen_bin_u64(head + 64);
+	file->input_size = test_gen_bin_u32(head + 24);
+	file->output_size = test_gen_bin_u32(head + 28);
+	if (
+		memcmp(head, "TGLUTBIN", 8) != 0 ||
+		test_gen_bin_u32(head + 8) != TEST_GEN_BIN_VERSION ||
+		test_gen_bin_u32(head + 12) != float_bits ||
+		test_gen_bin_u32(head + 16) != input_fields ||
+		test_gen_bin_u32(head + 20) != output_fields ||
+		file->input_size != input_size ||
+		file->output_size != output_size ||
+		TEST_GEN_BIN_HEADER_SIZE + (input_fields + output_fields) * TEST_GEN_BIN_FIELD_SIZE > file->size ||
+		memcmp(
+			head + TEST_GEN_BIN_HEADER_SIZE, fields,
+			(input_fields + output_fields) * TEST_GEN_BIN_FIELD_SIZE
+		) != 0 ||
+		!test_gen_bin_fits(input_offset, file->count, input_size, file->size) ||
+		!test_gen_bin_fits(output_offset, file->count, output_size, file->size)
+	) {
+		test_gen_bin_close(file);
+		return -1;
+	}
+	file->input = head + input_offset;
+	file->output = head + output_offset;
+	return 0;
+}
+
+/* @returns 0 if the records match the stored checksum */
+static inline int test_gen_bin_verify(const test_gen_bin_file* file) {
+	uint64_t hash = test_gen_bin_hash(file->input, (size_t)file->count * file->input_size, 0);
+	hash = test_gen_bin_hash(file->output, (size_t)file->count * file->output_size, hash);
+	return (hash == file->checksum) ? 0 : -1;
+}
+
+#endif /* TEST_GEN_BIN_H */
+)";
+}
+
+inline void export_binary_loader_source(Table_Cache* cache, const std::string& timestamp) {
+	const std::string text = binary_loader_source();
+	const uint64_t key = hash_string(text);
+	if (cache != nullptr && cache->is_fresh(binary_loader_file_name, key)) {
+		printf("Up to date \"%s\"\n", binary_loader_file_name);
+		return;
+	}
+	Write_Status status = write_cached_file(
+		cache, binary_loader_file_name, key, timestamp, text.size(), 0, 0,
+		[&](char* dst) {
+			std::memcpy(dst, text.data(), text.size());
+		}
+	);
+	print_write_status(status, binary_loader_file_name);
+}
+
+#endif /* BINARY_EXPORT_H */
@@ -0,0 +1,68 @@
+#ifndef BOUNDED_QUEUE_HPP
+#define BOUNDED_QUEUE_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+
+/*
+** A blocking queue of at most `capacity` items, connecting two pipeline
+** stages. push blocks while the queue is full, so a fast producer cannot
+** run ahead of a slow consumer by more than `capacity` items.
+*/
+template<typename T>
+class Bounded_Queue {
+public:
+	explicit Bounded_Queue(size_t max_items) : capacity(max_items == 0 ? 1 : max_items) {}
+
+	Bounded_Queue(const Bounded_Queue&) = delete;
+	Bounded_Queue& operator=(const Bounded_Queue&) = delete;
+
+	/* @returns false if the queue was closed, dropping the item */
+	bool push(T item) {
+		std::unique_lock<std::mutex> lock(mutex);
+		not_full.wait(lock, [this] { return closed || items.size() < capacity; });
+		if (closed) {
+			return false;
+		}
+		items.push_back(std::move(item));
+		lock.unlock();
+		not_empty.notify_one();
+		return true;
+	}
+
+	/* blocks until an item is available. @returns false once closed and drained */
+	bool pop(T& item) {
+		std::unique_lock<std::mutex> lock(mutex);
+		not_empty.wait(lock, [this] { return closed || !items.empty(); });
+		if (items.empty()) {
+			return false;
+		}
+		item = std::move(items.front());
+		items.pop_front();
+		lock.unlock();
+		not_full.notify_one();
+		return true;
+	}
+
+	/* no further items will be pushed */
+	void close() {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			closed = true;
+		}
+		not_empty.notify_all();
+		not_full.notify_all();
+	}
+
+private:
+	size_t capacity;
+	std::deque<T> items;
+	bool closed = false;
+	std::mutex mutex;
+	std::condition_variable not_empty;
+	std::condition_variable not_full;
+};
+
+#endif /* BOUNDED_QUEUE_HPP */
@@ -0,0 +1,275 @@
+#ifndef CORRECT_ROUND_H
+#define CORRECT_ROUND_H
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <math.h>
+
+#include "table_columns.hpp"
+
+#ifdef TEST_GEN_QUADMATH
+#include <quadmath.h>
+#endif
+
+/*
+** Correctly rounded reference values of functions that libm only rounds
+** faithfully. Ziv's strategy: a function is evaluated in a format wider
+** than the result, and if every value within the error bound of the wide
+** result rounds to the same result, that result is correctly rounded.
+** Otherwise the result lies too close to a midpoint, and the function is
+** evaluated again in a wider format:
+**   f32  double, then long double, then __float128
+**   f64  long double, then __float128
+** __float128 requires libquadmath (TEST_GEN_QUADMATH). Results still
+** ambiguous in the widest format are rounded from it, and counted as
+** unresolved. Escalations are rare, so the oracle runs at close to the
+** speed of the libm of the first format.
+*/
+
+/* the error bound assumed for libm, in ulps of the format evaluated in */
+constexpr int oracle_error_ulps = 8;
+
+/* rows evaluated in more than one format, and rows left unresolved, by the calling thread */
+inline thread_local uint64_t oracle_escalations = 0;
+inline thread_local uint64_t oracle_unresolved = 0;
+
+#ifdef TEST_GEN_QUADMATH
+using oracle_quad = __float128;
+#define ORACLE_QUAD(name) name##q
+#else
+using oracle_quad = long double;
+#define ORACLE_QUAD(name) nullptr
+#endif
+
+template<typename W, size_t arity>
+struct Oracle_Signature;
+
+template<typename W>
+struct Oracle_Signature<W, 1> {
+	using type = W (*)(W);
+};
+
+template<typename W>
+struct Oracle_Signature<W, 2> {
+	using type = W (*)(W, W);
+};
+
+template<typename W, size_t arity>
+using oracle_pointer = typename Oracle_Signature<W, arity>::type;
+
+template<size_t arity>
+struct Oracle_Function {
+	const char* name;
+	oracle_pointer<double, arity> f64;
+	oracle_pointer<long double, arity> f80;
+	/* null without libquadmath */
+	oracle_pointer<oracle_quad, arity> f128;
+
+	/* the function evaluated in format W */
+	template<typename W, typename... Args>
+	W evaluate(Args... args) const {
+		if constexpr (std::is_same_v<W, double>) {
+			return f64(static_cast<W>(args)...);
+		} else if constexpr (std::is_same_v<W, long double>) {
+			return f80(static_cast<W>(args)...);
+		} else {
+			return f128(static_cast<W>(args)...);
+		}
+	}
+};
+
+inline constexpr std::array<Oracle_Function<1>, 20> oracle_functions = {{
+	{"exp", ::exp, ::expl, ORACLE_QUAD(exp)},
+	{"exp2", ::exp2, ::exp2l, ORACLE_QUAD(exp2)},
+	{"expm1", ::expm1, ::expm1l, ORACLE_QUAD(expm1)},
+	{"log", ::log, ::logl, ORACLE_QUAD(log)},
+	{"log2", ::log2, ::log2l, ORACLE_QUAD(log2)},
+	{"log10", ::log10, ::log10l, ORACLE_QUAD(log10)},
+	{"log1p", ::log1p, ::log1pl, ORACLE_QUAD(log1p)},
+	{"sin", ::sin, ::sinl, ORACLE_QUAD(sin)},
+	{"cos", ::cos, ::cosl, ORACLE_QUAD(cos)},
+	{"tan", ::tan, ::tanl, ORACLE_QUAD(tan)},
+	{"asin", ::asin, ::asinl, ORACLE_QUAD(asin)},
+	{"acos", ::acos, ::acosl, ORACLE_QUAD(acos)},
+	{"atan", ::atan, ::atanl, ORACLE_QUAD(atan)},
+	{"sinh", ::sinh, ::sinhl, ORACLE_QUAD(sinh)},
+	{"cosh", ::cosh, ::coshl, ORACLE_QUAD(cosh)},
+	{"tanh", ::tanh, ::tanhl, ORACLE_QUAD(tanh)},
+	{"asinh", ::asinh, ::asinhl, ORACLE_QUAD(asinh)},
+	{"acosh", ::acosh, ::acoshl, ORACLE_QUAD(acosh)},
+	{"atanh", ::atanh, ::atanhl, ORACLE_QUAD(atanh)},
+	{"cbrt", ::cbrt, ::cbrtl, ORACLE_QUAD(cbrt)},
+}};
+
+inline constexpr std::array<Oracle_Function<2>, 3> oracle_binary_functions = {{
+	{"pow", ::pow, ::powl, ORACLE_QUAD(pow)},
+	{"atan2", ::atan2, ::atan2l, ORACLE_QUAD(atan2)},
+	{"hypot", ::hypot, ::hypotl, ORACLE_QUAD(hypot)},
+}};
+
+#undef ORACLE_QUAD
+
+template<typename W>
+struct Oracle_Format {
+	static constexpr W epsilon = std::numeric_limits<W>::epsilon();
+	static constexpr W denorm_min = std::numeric_limits<W>::denorm_min();
+};
+
+#ifdef TEST_GEN_QUADMATH
+template<>
+struct Oracle_Format<__float128> {
+	/* FLT128_EPSILON and FLT128_DENORM_MIN need the Q suffix of GNU C++ */
+	static inline const __float128 epsilon = scalbnq(1, 1 - FLT128_MANT_DIG);
+	static inline const __float128 denorm_min = scalbnq(1, FLT128_MIN_EXP - FLT128_MANT_DIG);
+};
+#endif
+
+/*
+** Rounds y to T if every value within oracle_error_ulps of y rounds to the
+** same value. @returns false if the rounding of the exact value is unknown
+*/
+template<typename T, typename W>
+inline bool round_unambiguous(W y, T& result) {
+	result = static_cast<T>(y);
+	if (!(y - y == 0)) {
+		/* infinite or NaN */
+		return true;
+	}
+	const W magnitude = (y < 0) ? -y : y;
+	/* one more ulp for the rounding of y - error and y + error */
+	const W error = (magnitude * Oracle_Format<W>::epsilon + Oracle_Format<W>::denorm_min) *
+		static_cast<W>(oracle_error_ulps + 1);
+	return static_cast<T>(y - error) == result && static_cast<T>(y + error) == result;
+}
+
+/*
+** Whether y is exactly halfway between two values of T. Results of __float128
+** that are, are taken to be exact, such as pow(1 + 0x1p-12f, 2), since an
+** inexact result lands exactly on a midpoint with negligible probability.
+*/
+template<typename T, typename W>
+inline bool is_exact_midpoint(W y, T result) {
+	if (!std::isfinite(result) || static_cast<W>(result) == y) {
+		return false;
+	}
+	const T other = std::nextafter(
+		result, (static_cast<W>(result) < y) ? std::numeric_limits<T>::infinity() :
+		-std::numeric_limits<T>::infinity()
+	);
+	return y == (static_cast<W>(result) + static_cast<W>(other)) / 2;
+}
+
+template<typename T>
+inline bool is_signaling_nan(T x) {
+	constexpr float_bits<T> quiet_bit = float_bits<T>(1) << (std::numeric_limits<T>::digits - 2);
+	return std::isnan(x) && (to_bits(x) & quiet_bit) == 0;
+}
+
+/* function(args...) rounded to nearest, ties to even */
+template<typename T, size_t arity, typename... Args>
+inline T correctly_rounded(const Oracle_Function<arity>& function, Args... args) {
+	if constexpr (arity == 1) {
+		for (T x : {args...}) {
+			if (std::isnan(x)) {
+				/* quiets a signaling NaN, keeping its payload */
+				return x + x;
+			}
+		}
+	} else {
+		/* pow(sNaN, 0) is NaN, unlike pow(qNaN, 0). Widening would quiet the NaN */
+		for (T x : {args...}) {
+			if (is_signaling_nan(x)) {
+				return x + x;
+			}
+		}
+	}
+	constexpr int digits = std::numeric_limits<T>::digits;
+	T result = 0;
+	/* formats tried so far */
+	int formats = 0;
+	if constexpr (digits < std::numeric_limits<double>::digits) {
+		if (round_unambiguous(function.template evaluate<double>(args...), result)) {
+			return result;
+		}
+		formats++;
+	}
+	if constexpr (digits < std::numeric_limits<long double>::digits) {
+		if (round_unambiguous(function.template evaluate<long double>(args...), result)) {
+			oracle_escalations += (formats != 0) ? 1 : 0;
+			return result;
+		}
+		formats++;
+	}
+	oracle_escalations += (formats != 0) ? 1 : 0;
+	if (function.f128 != nullptr) {
+		const oracle_quad y = function.template evaluate<oracle_quad>(args...);
+		if (round_unambiguous(y, result) || is_exact_midpoint(y, result)) {
+			return result;
+		}
+	} else if (formats == 0) {
+		/* long double is no wider than T */
+		result = static_cast<T>(function.template evaluate<long double>(args...));
+	}
+	oracle_unresolved++;
+	return result;
+}
+
+/* the function is a constant, so that its calls are direct */
+template <typename T, size_t index>
+inline void evaluate_correctly_rounded(
+	const Record_Columns& input,
+	Record_Columns& output,
+	size_t begin, size_t end
+) {
+	constexpr const Oracle_Function<1>& function = oracle_functions[index];
+	auto x = input[0].values<float_bits<T>>();
+	auto y = output[0].values<float_bits<T>>();
+	for (size_t i = begin; i < end; i++) {
+		y[i] = to_bits(correctly_rounded<T>(function, from_bits<T>(x[i])));
+	}
+}
+
+template <typename T, size_t index>
+inline void evaluate_correctly_rounded_binary(
+	const Record_Columns& input,
+	Record_Columns& output,
+	size_t begin, size_t end
+) {
+	constexpr const Oracle_Function<2>& function = oracle_binary_functions[index];
+	auto x = input[0].values<float_bits<T>>();
+	auto y = input[1].values<float_bits<T>>();
+	auto result = output[0].values<float_bits<T>>();
+	for (size_t i = begin; i < end; i++) {
+		result[i] = to_bits(
+			correctly_rounded<T>(function, from_bits<T>(x[i]), from_bits<T>(y[i]))
+		);
+	}
+}
+
+template<typename T, size_t... index>
+constexpr auto correctly_rounded_evaluators(std::index_sequence<index...>) {
+	return std::array{&evaluate_correctly_rounded<T, index>...};
+}
+
+template<typename T, size_t... index>
+constexpr auto correctly_rounded_binary_evaluators(std::index_sequence<index...>) {
+	return std::array{&evaluate_correctly_rounded_binary<T, index>...};
+}
+
+/* evaluate_correctly_rounded of each of oracle_functions */
+template<typename T>
+inline constexpr auto correctly_rounded_evaluator =
+	correctly_rounded_evaluators<T>(std::make_index_sequence<oracle_functions.size()>());
+
+/* evaluate_correctly_rounded_binary of each of oracle_binary_functions */
+template<typename T>
+inline constexpr auto correctly_rounded_binary_evaluator = correctly_rounded_binary_evaluators<T>(
+	std::make_index_sequence<oracle_binary_functions.size()>()
+);
+
+#endif /* CORRECT_ROUND_H */
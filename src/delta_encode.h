@@ -0,0 +1,375 @@
+#ifndef DELTA_ENCODE_H
+#define DELTA_ENCODE_H
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "binary_export.h"
+#include "hex_encode.h"
+#include "table_cache.hpp"
+#include "table_columns.hpp"
+#include "table_writer.h"
+
+/*
+** Encoded tables store each record as a bit stream of its columns (the
+** inputs, then the outputs). Every column has a fixed descriptor:
+**   ref:    0, or 1 + the index of an earlier column of the same width,
+**           which is XORed out of the value
+**   zigzag: the residual is zigzag encoded, for small negative integers
+**   packed: the residual is stored as
+**             0                                    if it is zero
+**             1, leading zeros, length - 1, bits   otherwise
+**           with 5bit counts for 32bit columns and 6bit counts for 64bit
+**           columns, else it is stored in full
+** The descriptor of each column is whichever encodes the table in the
+** fewest bits, so sqrt(x) is XORed with x, u32 with i32, and exponents are
+** zigzag encoded, while random inputs are stored as is.
+**
+** Bits are packed least significant first. Exponents are stored like the
+** binary format, as the host INT_MAX, FP_ILOGBNAN, and FP_ILOGB0.
+*/
+
+struct Encoded_Column {
+	uint8_t width;
+	uint8_t ref;
+	uint8_t zigzag;
+	uint8_t packed;
+};
+
+constexpr const char* encoded_decoder_file_name = "test_gen_dec.h";
+
+inline uint64_t width_mask(unsigned width) {
+	return (width == 64) ? ~UINT64_C(0) : (UINT64_C(1) << width) - 1;
+}
+
+inline uint64_t zigzag_encode(uint64_t x, unsigned width) {
+	uint64_t sign = ((x >> (width - 1)) & 1) ? width_mask(width) : 0;
+	return ((x << 1) ^ sign) & width_mask(width);
+}
+
+/* bits of x as a 32bit or 64bit column value, with exponents as host ints */
+inline uint64_t encoded_field_value(const Column& column, size_t i) {
+	uint64_t raw = column.raw(i);
+	if (column.field.kind == Field_Kind::expon) {
+		return static_cast<uint32_t>(binary_expon_value(static_cast<int64_t>(raw)));
+	}
+	return raw & width_mask(static_cast<unsigned>(8 * field_size(column.field.kind)));
+}
+
+inline unsigned count_bits_log2(unsigned width) {
+	return (width == 64) ? 6 : 5;
+}
+
+inline uint64_t encoded_residual(uint64_t value, uint64_t ref_value, const Encoded_Column& desc) {
+	uint64_t x = value ^ ref_value;
+	return desc.zigzag ? zigzag_encode(x, desc.width) : x;
+}
+
+inline size_t encoded_residual_bits(uint64_t x, const Encoded_Column& desc) {
+	if (!desc.packed) {
+		return desc.width;
+	}
+	if (x == 0) {
+		return 1;
+	}
+	unsigned lz = static_cast<unsigned>(std::countl_zero(x)) - (64 - desc.width);
+	unsigned tz = static_cast<unsigned>(std::countr_zero(x));
+	return 1 + 2 * count_bits_log2(desc.width) + (desc.width - lz - tz);
+}
+
+class Bit_Writer {
+public:
+	void put(uint64_t value, unsigned count) {
+		for (unsigned i = 0; i < count; i++, bit++) {
+			if ((bit & 7) == 0) {
+				bytes.push_back(0);
+			}
+			bytes.back() |= static_cast<uint8_t>(((value >> i) & 1) << (bit & 7));
+		}
+	}
+
+	const std::vector<uint8_t>& data() const {
+		return bytes;
+	}
+
+private:
+	std::vector<uint8_t> bytes;
+	uint64_t bit = 0;
+};
+
+inline void put_residual(Bit_Writer& writer, uint64_t x, const Encoded_Column& desc) {
+	if (!desc.packed) {
+		writer.put(x, desc.width);
+		return;
+	}
+	writer.put(x != 0, 1);
+	if (x == 0) {
+		return;
+	}
+	const unsigned count_bits = count_bits_log2(desc.width);
+	unsigned lz = static_cast<unsigned>(std::countl_zero(x)) - (64 - desc.width);
+	unsigned tz = static_cast<unsigned>(std::countr_zero(x));
+	unsigned len = desc.width - lz - tz;
+	writer.put(lz, count_bits);
+	writer.put(len - 1, count_bits);
+	writer.put(x >> tz, len);
+}
+
+/* the input columns followed by the output columns */
+inline std::vector<const Column*> encoded_columns(
+	const Record_Columns& input, const Record_Columns& output
+) {
+	std::vector<const Column*> columns;
+	for (const Column& column : input.columns) {
+		columns.push_back(&column);
+	}
+	for (const Column& column : output.columns) {
+		columns.push_back(&column);
+	}
+	return columns;
+}
+
+inline uint64_t column_residual(
+	const std::vector<const Column*>& columns, size_t c, const Encoded_Column& desc, size_t i
+) {
+	uint64_t ref_value = (desc.ref == 0) ? 0 : encoded_field_value(*columns[desc.ref - 1], i);
+	return encoded_residual(encoded_field_value(*columns[c], i), ref_value, desc);
+}
+
+/* picks the descriptor of each column that encodes it in the fewest bits */
+inline std::vector<Encoded_Column> choose_encoding(
+	const std::vector<const Column*>& columns, size_t count
+) {
+	std::vector<Encoded_Column> ret;
+	for (size_t c = 0; c < columns.size(); c++) {
+		const uint8_t width = static_cast<uint8_t>(8 * field_size(columns[c]->field.kind));
+		Encoded_Column best = {width, 0, 0, 0};
+		size_t best_bits = SIZE_MAX;
+		for (size_t ref = 0; ref <= c; ref++) {
+			if (ref != 0 && 8 * field_size(columns[ref - 1]->field.kind) != width) {
+				continue;
+			}
+			for (uint8_t zigzag = 0; zigzag < 2; zigzag++) {
+				for (uint8_t packed = 0; packed < 2; packed++) {
+					const Encoded_Column desc = {width, static_cast<uint8_t>(ref), zigzag, packed};
+					size_t bits = 0;
+					for (size_t i = 0; i < count; i++) {
+						bits += encoded_residual_bits(column_residual(columns, c, desc, i), desc);
+					}
+					if (bits < best_bits) {
+						best = desc;
+						best_bits = bits;
+					}
+				}
+			}
+		}
+		ret.push_back(best);
+	}
+	return ret;
+}
+
+inline std::vector<uint8_t> encode_records(
+	const std::vector<const Column*>& columns, const std::vector<Encoded_Column>& descs,
+	size_t count
+) {
+	Bit_Writer writer;
+	for (size_t i = 0; i < count; i++) {
+		for (size_t c = 0; c < columns.size(); c++) {
+			put_residual(writer, column_residual(columns, c, descs[c], i), descs[c]);
+		}
+	}
+	return writer.data();
+}
+
+/* `dst->name = (type)values[c];` for every field of a layout */
+inline std::string decode_assignments(
+	const Record_Layout& layout, const std::string& dst, size_t first_value
+) {
+	std::string ret;
+	for (size_t c = 0; c < layout.size(); c++) {
+		const Field& field = layout.fields[c];
+		std::string target = layout.is_scalar() ? "*" + dst : dst + "->" + field.name;
+		std::string type = field_c_type(field.kind);
+		std::string value = "values[" + std::to_string(first_value + c) + "]";
+		if (type == "int") {
+			value = "(int32_t)" + value;
+		}
+		ret += "\t" + target + " = (" + type + ")" + value + ";\n";
+	}
+	return ret;
+}
+
+struct Encoded_Table {
+	/* such as f32_sqrt_LUT, the file is f32_sqrt_LUT_enc.h */
+	std::string prefix;
+	std::string headers;
+	std::string timestamp;
+	const Record_Layout& input_layout;
+	const Record_Layout& output_layout;
+	const Record_Columns& input;
+	const Record_Columns& output;
+};
+
+inline Write_Status export_encoded_table(
+	const Encoded_Table& table, Table_Cache* cache, uint64_t key
+) {
+	const std::string name = table.prefix + "_enc";
+	const std::string file_name = name + ".h";
+	std::string guard = file_name;
+	std::transform(guard.begin(), guard.end(), guard.begin(), ::toupper);
+	std::replace(guard.begin(), guard.end(), '.', '_');
+	std::string macro = name;
+	std::transform(macro.begin(), macro.end(), macro.begin(), ::toupper);
+
+	const std::vector<const Column*> columns = encoded_columns(table.input, table.output);
+	const size_t count = table.input.size();
+	const std::vector<Encoded_Column> descs = choose_encoding(columns, count);
+	const std::vector<uint8_t> data = encode_records(columns, descs, count);
+	const size_t raw_size =
+		count * (table.input_layout.record_size() + table.output_layout.record_size());
+
+	std::string text;
+	text += "#ifndef " + guard + "\n";
+	text += "#define " + guard + "\n\n";
+	text += table.headers + "\n";
+	text += "#include \"" + std::string(encoded_decoder_file_name) + "\"\n\n";
+	const size_t timestamp_begin = text.size();
+	text += "/* Generated " + table.timestamp + " */\n\n";
+	const size_t timestamp_end = text.size();
+	char ratio[128];
+	snprintf(
+		ratio, sizeof(ratio), "/* %zu records in %zu bytes, %.2f times smaller than the arrays */\n\n",
+		count, data.size(),
+		data.empty() ? 0.0 : static_cast<double>(raw_size) / static_cast<double>(data.size())
+	);
+	text += ratio;
+	text += "typedef " + table.input_layout.c_type() + " " + name + "_input_type;\n\n";
+	text += "typedef " + table.output_layout.c_type() + " " + name + "_output_type;\n\n";
+	text += "#define " + macro + "_COUNT " + std::to_string(count) + "\n\n";
+	text += "static const test_gen_dec_column " + name + "_columns[" +
+		std::to_string(descs.size()) + "] = {\n";
+	for (const Encoded_Column& desc : descs) {
+		text += "\t{" + std::to_string(desc.width) + ", " + std::to_string(desc.ref) + ", " +
+			std::to_string(desc.zigzag) + ", " + std::to_string(desc.packed) + "},\n";
+	}
+	text += "};\n\n";
+	const size_t array_size = std::max<size_t>(data.size(), 1);
+	text += "const uint8_t " + name + "[" + std::to_string(array_size) + "] = {";
+	for (size_t i = 0; i < data.size(); i++) {
+		text += (i % 16 == 0) ? "\n\t" : " ";
+		text += "0x";
+		text += hex_byte_table[2 * data[i]];
+		text += hex_byte_table[2 * data[i] + 1];
+		text += ",";
+	}
+	text += data.empty() ? "0\n};\n\n" : "\n};\n\n";
+	text += "/* decodes the next record, starting from test_gen_dec_init(dec, " + name + ") */\n";
+	text += "static inline void " + name + "_next(\n";
+	text += "\ttest_gen_dec* dec, " + name + "_input_type* input, " + name + "_output_type* output\n";
+	text += ") {\n";
+	text += "\tuint64_t values[" + std::to_string(descs.size()) + "];\n";
+	text += "\ttest_gen_dec_record(dec, " + name + "_columns, " +
+		std::to_string(descs.size()) + ", values);\n";
+	text += decode_assignments(table.input_layout, "input", 0);
+	text += decode_assignments(table.output_layout, "output", table.input_layout.size());
+	text += "}\n\n";
+	text += "#endif /* " + guard + " */\n";
+
+	Write_Status status = write_cached_file(
+		cache, file_name, key, table.timestamp, text.size(), timestamp_begin, timestamp_end,
+		[&](char* dst) {
+			std::memcpy(dst, text.data(), text.size());
+		}
+	);
+	print_write_status(status, file_name);
+	return status;
+}
+
+/* shared by every encoded table */
+inline const char* encoded_decoder_source() {
+	return
+R"(#ifndef TEST_GEN_DEC_H
+#define TEST_GEN_DEC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct {
+	uint8_t width;
+	uint8_t ref;
+	uint8_t zigzag;
+	uint8_t packed;
+} test_gen_dec_column;
+
+typedef struct {
+	const uint8_t* data;
+	uint32_t bit;
+} test_gen_dec;
+
+static inline void test_gen_dec_init(test_gen_dec* dec, const uint8_t* data) {
+	dec->data = data;
+	dec->bit = 0;
+}
+
+static inline uint64_t test_gen_dec_bits(test_gen_dec* dec, unsigned count) {
+	uint64_t ret = 0;
+	unsigned i;
+	for (i = 0; i < count; i++, dec->bit++) {
+		ret |= (uint64_t)((dec->data[dec->bit >> 3] >> (dec->bit & 7)) & 1) << i;
+	}
+	return ret;
+}
+
+static inline void test_gen_dec_record(
+	test_gen_dec* dec, const test_gen_dec_column* columns, size_t count, uint64_t* values
+) {
+	size_t c;
+	for (c = 0; c < count; c++) {
+		const test_gen_dec_column* col = &columns[c];
+		const uint64_t mask = (col->width == 64) ? ~(uint64_t)0 : ((uint64_t)1 << col->width) - 1;
+		uint64_t x = 0;
+		if (!col->packed) {
+			x = test_gen_dec_bits(dec, col->width);
+		} else if (test_gen_dec_bits(dec, 1)) {
+			unsigned count_bits = (col->width == 64) ? 6 : 5;
+			unsigned lz = (unsigned)test_gen_dec_bits(dec, count_bits);
+			unsigned len = (unsigned)test_gen_dec_bits(dec, count_bits) + 1;
+			x = test_gen_dec_bits(dec, len) << (col->width - lz - len);
+		}
+		if (col->zigzag) {
+			x = (x >> 1) ^ ((x & 1) ? mask : 0);
+		}
+		if (col->ref != 0) {
+			x ^= values[col->ref - 1];
+		}
+		values[c] = x & mask;
+	}
+}
+
+#endif /* TEST_GEN_DEC_H */
+)";
+}
+
+inline void export_encoded_decoder_source(Table_Cache* cache, const std::string& timestamp) {
+	const std::string text = encoded_decoder_source();
+	const uint64_t key = hash_string(text);
+	if (cache != nullptr && cache->is_fresh(encoded_decoder_file_name, key)) {
+		printf("Up to date \"%s\"\n", encoded_decoder_file_name);
+		return;
+	}
+	Write_Status status = write_cached_file(
+		cache, encoded_decoder_file_name, key, timestamp, text.size(), 0, 0,
+		[&](char* dst) {
+			std::memcpy(dst, text.data(), text.size());
+		}
+	);
+	print_write_status(status, encoded_decoder_file_name);
+}
+
+#endif /* DELTA_ENCODE_H */
@@ -0,0 +1,355 @@
+#ifndef DRIVER_EXPORT_H
+#define DRIVER_EXPORT_H
+
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "table_cache.hpp"
+#include "table_columns.hpp"
+#include "table_writer.h"
+#include "test_gen.hpp"
+
+struct Driver_Table {
+	std::string prefix;
+	std::string header_file;
+	const Record_Layout& input_layout;
+	const Record_Layout& output_layout;
+	const std::vector<Driver_Call>& calls;
+	/* whether results may be accepted within TEST_GEN_MAX_ULPS of the table */
+	bool correctly_rounded;
+};
+
+/* tg_call_<macro> */
+inline std::string driver_call_function(const std::string& macro) {
+	std::string name = "tg_call_" + macro;
+	for (char& c : name) {
+		c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+	}
+	return name;
+}
+
+inline std::string driver_file_name(const std::string& prefix) {
+	return prefix + "_driver.c";
+}
+
+inline std::string driver_local_name(const Record_Layout& layout, size_t i, bool output) {
+	if (layout.is_scalar()) {
+		return output ? "result" : "x";
+	}
+	return layout.fields[i].name;
+}
+
+inline std::string driver_field_access(
+	const Record_Layout& layout, size_t i, const char* record
+) {
+	if (layout.is_scalar()) {
+		return std::string("*") + record;
+	}
+	return std::string(record) + "->" + layout.fields[i].name;
+}
+
+inline const char* driver_local_type(Field_Kind kind) {
+	switch (kind) {
+		case Field_Kind::f32: return "tg_f32";
+		case Field_Kind::f64: return "tg_f64";
+		case Field_Kind::u32: return "uint32_t";
+		case Field_Kind::i32: return "int32_t";
+		case Field_Kind::u64: return "uint64_t";
+		case Field_Kind::i64: return "int64_t";
+		case Field_Kind::int_dec: return "int";
+		case Field_Kind::expon: return "int";
+	}
+	return "";
+}
+
+/* a local from a stored field, or the reverse */
+inline std::string driver_unpack(Field_Kind kind, const std::string& stored) {
+	switch (kind) {
+		case Field_Kind::f32: return "tg_from_f32(" + stored + ")";
+		case Field_Kind::f64: return "tg_from_f64(" + stored + ")";
+		default: return stored;
+	}
+}
+
+inline std::string driver_pack(Field_Kind kind, const std::string& local) {
+	switch (kind) {
+		case Field_Kind::f32: return "tg_to_f32(" + local + ")";
+		case Field_Kind::f64: return "tg_to_f64(" + local + ")";
+		default: return std::string("(") + field_c_type(kind) + ")" + local;
+	}
+}
+
+inline bool layouts_use(const Driver_Table& table, Field_Kind kind) {
+	for (const Record_Layout* layout : {&table.input_layout, &table.output_layout}) {
+		for (const Field& field : layout->fields) {
+			if (field.kind == kind) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+inline std::string driver_source(const Driver_Table& table) {
+	std::string macro_prefix = table.prefix;
+	for (char& c : macro_prefix) {
+		c = static_cast<char>(toupper(static_cast<unsigned char>(c)));
+	}
+	const std::string input = table.prefix + "_input";
+	const std::string output = table.prefix + "_output";
+	const Record_Layout& in = table.input_layout;
+	const Record_Layout& out = table.output_layout;
+
+	std::string text;
+	text += "/*\n";
+	text += "** Runs " + table.header_file + " through the routines below, comparing the\n";
+	text += "** results bitwise and timing them with TEST_GEN_CYCLES(), such as a cycle\n";
+	text += "** counter read, in units of TEST_GEN_CYCLES_UNIT. It defaults to C11\n";
+	text += "** timespec_get in nanoseconds. Define TEST_GEN_ANY_NAN to accept any NaN\n";
+	text += "** for a NaN, TEST_GEN_F32_TYPE/TEST_GEN_F64_TYPE for the C types of f32\n";
+	text += "** and f64, and TEST_GEN_F32_LIBM(name)/TEST_GEN_F64_LIBM(name) for the\n";
+	text += "** names of their libm functions.\n";
+	if (table.correctly_rounded) {
+		text += "** The results are correctly rounded. Define TEST_GEN_MAX_ULPS to accept\n";
+		text += "** results within that many ulps, such as from a faithfully rounded libm.\n";
+	}
+	text += "** Exits with 1 if any row differs.\n";
+	text += "*/\n\n";
+	text += "#include <inttypes.h>\n#include <limits.h>\n#include <math.h>\n#include <stddef.h>\n";
+	text += "#include <stdint.h>\n#include <stdio.h>\n#include <string.h>\n\n";
+	text += "#include \"" + table.header_file + "\"\n\n";
+
+	text += "#ifndef TEST_GEN_CYCLES\n#include <time.h>\n";
+	text += "static uint64_t tg_nanoseconds(void) {\n";
+	text += "\tstruct timespec now;\n\ttimespec_get(&now, TIME_UTC);\n";
+	text += "\treturn (uint64_t)now.tv_sec * UINT64_C(1000000000) + (uint64_t)now.tv_nsec;\n}\n";
+	text += "#define TEST_GEN_CYCLES() tg_nanoseconds()\n";
+	text += "#define TEST_GEN_CYCLES_UNIT \"ns\"\n#endif\n\n";
+	text += "#ifndef TEST_GEN_CYCLES_UNIT\n#define TEST_GEN_CYCLES_UNIT \"cycles\"\n#endif\n\n";
+	text += "#ifndef TEST_GEN_REPEAT\n#define TEST_GEN_REPEAT 8\n#endif\n\n";
+	if (layouts_use(table, Field_Kind::f32)) {
+		text += "#ifndef TEST_GEN_F32_TYPE\n#define TEST_GEN_F32_TYPE float\n#endif\n";
+		text += "typedef TEST_GEN_F32_TYPE tg_f32;\n";
+		text += "_Static_assert(sizeof(tg_f32) == 4, \"define TEST_GEN_F32_TYPE\");\n\n";
+		text += "static inline tg_f32 tg_from_f32(uint32_t bits) {\n";
+		text += "\ttg_f32 x;\n\tmemcpy(&x, &bits, sizeof(x));\n\treturn x;\n}\n\n";
+		text += "static inline uint32_t tg_to_f32(tg_f32 x) {\n";
+		text += "\tuint32_t bits;\n\tmemcpy(&bits, &x, sizeof(bits));\n\treturn bits;\n}\n\n";
+		text += "#ifndef TEST_GEN_F32_LIBM\n#define TEST_GEN_F32_LIBM(name) name##f\n#endif\n\n";
+	}
+	if (layouts_use(table, Field_Kind::f64)) {
+		text += "#ifndef TEST_GEN_F64_TYPE\n#define TEST_GEN_F64_TYPE long double\n#endif\n";
+		text += "typedef TEST_GEN_F64_TYPE tg_f64;\n";
+		text += "_Static_assert(sizeof(tg_f64) == 8, \"define TEST_GEN_F64_TYPE\");\n\n";
+		text += "static inline tg_f64 tg_from_f64(uint64_t bits) {\n";
+		text += "\ttg_f64 x;\n\tmemcpy(&x, &bits, sizeof(x));\n\treturn x;\n}\n\n";
+		text += "static inline uint64_t tg_to_f64(tg_f64 x) {\n";
+		text += "\tuint64_t bits;\n\tmemcpy(&bits, &x, sizeof(bits));\n\treturn bits;\n}\n\n";
+		text += "#ifndef TEST_GEN_F64_LIBM\n#define TEST_GEN_F64_LIBM(name) name##l\n#endif\n\n";
+	}
+	if (layouts_use(table, Field_Kind::expon)) {
+		/* the table stores the frexp exponent of zero, infinity and NaN as ilogb does */
+		for (Field_Kind kind : {Field_Kind::f32, Field_Kind::f64}) {
+			if (!layouts_use(table, kind)) {
+				continue;
+			}
+			const bool wide = (kind == Field_Kind::f64);
+			const std::string fX = wide ? "f64" : "f32";
+			const char* bits = wide ? "uint64_t" : "uint32_t";
+			const char* abs_mask = wide ? "UINT64_C(0x7FFFFFFFFFFFFFFF)" : "UINT32_C(0x7FFFFFFF)";
+			const char* inf = wide ? "UINT64_C(0x7FF0000000000000)" : "UINT32_C(0x7F800000)";
+			text += "static inline int tg_classify_expon_" + fX;
+			text += "(tg_" + fX + " x, int expon) {\n";
+			text += "\tconst " + std::string(bits) + " bits = tg_to_" + fX + "(x) & " + abs_mask;
+			text += ";\n";
+			text += "\tif (bits > " + std::string(inf) + ") {\n\t\treturn FP_ILOGBNAN;\n\t}\n";
+			text += "\tif (bits == " + std::string(inf) + ") {\n\t\treturn INT_MAX;\n\t}\n";
+			text += "\treturn (bits == 0) ? FP_ILOGB0 : expon;\n}\n\n";
+		}
+	}
+
+	for (const Driver_Call& call : table.calls) {
+		const std::string macro = macro_prefix + "_" + call.macro;
+		text += "#ifndef " + macro + "\n";
+		if (call.default_routine.empty()) {
+			text += "#error \"define " + macro + " to the routine under test\"\n";
+		} else {
+			text += "#define " + macro + " " + call.default_routine + "\n";
+		}
+		text += "#endif\n\n";
+	}
+	text += "#define TG_COUNT (sizeof(" + input + ") / sizeof(" + input + "[0]))\n\n";
+
+	/* one function per call, and an empty one to time the overhead */
+	for (size_t c = 0; c <= table.calls.size(); c++) {
+		const bool baseline = (c == table.calls.size());
+		const std::string macro = baseline ? "baseline" : table.calls[c].macro;
+		text += "static inline void " + driver_call_function(macro);
+		text += "(const input_type* in, output_type* out) {\n";
+		for (size_t i = 0; i < in.size(); i++) {
+			const std::string local = driver_local_name(in, i, false);
+			text += "\tconst " + std::string(driver_local_type(in.fields[i].kind)) + " " + local;
+			text += " = " + driver_unpack(in.fields[i].kind, driver_field_access(in, i, "in"));
+			text += ";\n";
+			text += "\t(void)" + local + ";\n";
+		}
+		for (size_t i = 0; i < out.size(); i++) {
+			text += "\t" + std::string(driver_local_type(out.fields[i].kind)) + " ";
+			text += driver_local_name(out, i, true) + " = ";
+			text += driver_unpack(out.fields[i].kind, driver_field_access(out, i, "out"));
+			text += ";\n";
+		}
+		if (!baseline) {
+			std::string statement = table.calls[c].statement;
+			const size_t pos = statement.find("ROUTINE");
+			if (pos != std::string::npos) {
+				statement.replace(pos, strlen("ROUTINE"), macro_prefix + "_" + macro);
+			}
+			text += "\t" + statement + "\n";
+		}
+		for (size_t i = 0; i < out.size(); i++) {
+			text += "\t" + driver_field_access(out, i, "out") + " = ";
+			text += driver_pack(out.fields[i].kind, driver_local_name(out, i, true)) + ";\n";
+		}
+		text += "}\n\n";
+	}
+
+	if (table.correctly_rounded) {
+		text += "#ifndef TEST_GEN_MAX_ULPS\n#define TEST_GEN_MAX_ULPS 0\n#endif\n";
+		text += "#define TG_MAX_ULPS TEST_GEN_MAX_ULPS\n\n";
+	} else {
+		text += "#define TG_MAX_ULPS 0\n\n";
+	}
+	text += "static int tg_field_equal(uint64_t expected, uint64_t got, int float_bits) {\n";
+	text += "\tif (expected == got) {\n\t\treturn 1;\n\t}\n";
+	text += "\tif (float_bits != 0) {\n";
+	text += "\t\tconst uint64_t sign = UINT64_C(1) << (float_bits - 1);\n";
+	text += "\t\tconst uint64_t inf =\n";
+	text += "\t\t\t(float_bits == 32) ? 0x7F800000 : UINT64_C(0x7FF0000000000000);\n";
+	text += "\t\tconst int expected_nan = (expected & (sign - 1)) > inf;\n";
+	text += "\t\tconst int got_nan = (got & (sign - 1)) > inf;\n";
+	text += "#ifdef TEST_GEN_ANY_NAN\n";
+	text += "\t\tif (expected_nan && got_nan) {\n\t\t\treturn 1;\n\t\t}\n";
+	text += "#endif\n";
+	text += "\t\tif (TG_MAX_ULPS != 0 && !expected_nan && !got_nan) {\n";
+	text += "\t\t\t/* distance in ulps, with -0 and +0 the same value */\n";
+	text += "\t\t\tconst int64_t e = (expected & sign) ?\n";
+	text += "\t\t\t\t-(int64_t)(expected & (sign - 1)) : (int64_t)expected;\n";
+	text += "\t\t\tconst int64_t g = (got & sign) ? -(int64_t)(got & (sign - 1)) : (int64_t)got;\n";
+	text += "\t\t\tconst uint64_t distance = (e > g) ? (uint64_t)(e - g) : (uint64_t)(g - e);\n";
+	text += "\t\t\treturn distance <= (uint64_t)TG_MAX_ULPS;\n";
+	text += "\t\t}\n";
+	text += "\t}\n";
+	text += "\treturn 0;\n}\n\n";
+
+	/* every field as uint64_t, with its float width */
+	text += "static size_t tg_fields(\n";
+	text += "\tconst output_type* out, uint64_t* values, int* float_bits\n";
+	text += ") {\n";
+	for (size_t i = 0; i < out.size(); i++) {
+		const Field_Kind kind = out.fields[i].kind;
+		const int float_width =
+			(kind == Field_Kind::f32) ? 32 : (kind == Field_Kind::f64) ? 64 : 0;
+		const std::string index = std::to_string(i);
+		text += "\tvalues[" + index + "] = (uint64_t)" + driver_field_access(out, i, "out") + ";\n";
+		text += "\tfloat_bits[" + index + "] = " + std::to_string(float_width) + ";\n";
+	}
+	text += "\treturn " + std::to_string(out.size()) + ";\n}\n\n";
+
+	text += "#define TG_TIME(call, cycles) do { \\\n";
+	text += "\tuint64_t best = UINT64_MAX; \\\n";
+	text += "\tfor (int repeat = 0; repeat < TEST_GEN_REPEAT; repeat++) { \\\n";
+	text += "\t\toutput_type out; \\\n";
+	text += "\t\tmemset(&out, 0, sizeof(out)); \\\n";
+	text += "\t\tconst uint64_t start = TEST_GEN_CYCLES(); \\\n";
+	text += "\t\tfor (size_t i = 0; i < TG_COUNT; i++) { \\\n";
+	text += "\t\t\tcall(&" + input + "[i], &out); \\\n";
+	text += "\t\t\ttg_sink ^= tg_fold(&out); \\\n";
+	text += "\t\t} \\\n";
+	text += "\t\tconst uint64_t end = TEST_GEN_CYCLES(); \\\n";
+	text += "\t\tif (end - start < best) { \\\n";
+	text += "\t\t\tbest = end - start; \\\n";
+	text += "\t\t} \\\n";
+	text += "\t} \\\n";
+	text += "\t(cycles) = best; \\\n";
+	text += "} while (0)\n\n";
+
+	text += "static volatile uint64_t tg_sink;\n\n";
+	text += "static inline uint64_t tg_fold(const output_type* out) {\n";
+	text += "\tuint64_t values[" + std::to_string(out.size()) + "];\n";
+	text += "\tint float_bits[" + std::to_string(out.size()) + "];\n";
+	text += "\tconst size_t field_count = tg_fields(out, values, float_bits);\n";
+	text += "\tuint64_t fold = 0;\n";
+	text += "\tfor (size_t f = 0; f < field_count; f++) {\n";
+	text += "\t\tfold ^= values[f];\n\t}\n\treturn fold;\n}\n\n";
+
+	text += "int main(void) {\n";
+	text += "\tsize_t mismatches = 0;\n";
+	text += "\tfor (size_t i = 0; i < TG_COUNT; i++) {\n";
+	text += "\t\toutput_type out;\n";
+	text += "\t\tmemset(&out, 0, sizeof(out));\n";
+	for (const Driver_Call& call : table.calls) {
+		text += "\t\t" + driver_call_function(call.macro) + "(&" + input + "[i], &out);\n";
+	}
+	text += "\t\tuint64_t expected[" + std::to_string(out.size()) + "];\n";
+	text += "\t\tuint64_t got[" + std::to_string(out.size()) + "];\n";
+	text += "\t\tint float_bits[" + std::to_string(out.size()) + "];\n";
+	text += "\t\tconst size_t field_count = tg_fields(&" + output + "[i], expected, float_bits);\n";
+	text += "\t\ttg_fields(&out, got, float_bits);\n";
+	text += "\t\tfor (size_t f = 0; f < field_count; f++) {\n";
+	text += "\t\t\tif (!tg_field_equal(expected[f], got[f], float_bits[f])) {\n";
+	text += "\t\t\t\tif (mismatches < 8) {\n";
+	text += "\t\t\t\t\tprintf(\n";
+	text += "\t\t\t\t\t\t\"row %zu field %zu: expected 0x%\" PRIX64 \", got 0x%\" PRIX64 \"\\n\",\n";
+	text += "\t\t\t\t\t\ti, f, expected[f], got[f]\n";
+	text += "\t\t\t\t\t);\n";
+	text += "\t\t\t\t}\n";
+	text += "\t\t\t\tmismatches++;\n";
+	text += "\t\t\t\tbreak;\n";
+	text += "\t\t\t}\n";
+	text += "\t\t}\n";
+	text += "\t}\n\n";
+
+	text += "\tuint64_t baseline;\n";
+	text += "\tTG_TIME(tg_call_baseline, baseline);\n";
+	for (const Driver_Call& call : table.calls) {
+		text += "\t{\n";
+		text += "\t\tuint64_t cycles;\n";
+		text += "\t\tTG_TIME(" + driver_call_function(call.macro) + ", cycles);\n";
+		text += "\t\tcycles = (cycles > baseline) ? cycles - baseline : 0;\n";
+		text += "\t\tprintf(\n";
+		text += "\t\t\t\"%s: %.2f %s/call\\n\", \"" + macro_prefix + "_" + call.macro + "\",\n";
+		text += "\t\t\t(double)cycles / (double)TG_COUNT, TEST_GEN_CYCLES_UNIT\n";
+		text += "\t\t);\n";
+		text += "\t}\n";
+	}
+	text += "\tprintf(\"%zu of %zu rows differ\\n\", mismatches, (size_t)TG_COUNT);\n";
+	text += "\treturn (mismatches != 0) ? 1 : 0;\n";
+	text += "}\n";
+	return text;
+}
+
+/* drivers only depend on the layouts and calls of a table, so they are keyed by their text */
+inline void export_driver(const Driver_Table& table, Table_Cache* cache) {
+	const std::string file_name = driver_file_name(table.prefix);
+	const std::string text = driver_source(table);
+	const uint64_t key = hash_string(text);
+	if (cache != nullptr && cache->is_fresh(file_name, key)) {
+		printf("Up to date \"%s\"\n", file_name.c_str());
+		return;
+	}
+	Write_Status status = write_cached_file(
+		cache, file_name, key, "", text.size(), 0, 0,
+		[&](char* dst) {
+			std::memcpy(dst, text.data(), text.size());
+		}
+	);
+	print_write_status(status, file_name);
+}
+
+#endif /* DRIVER_EXPORT_H */
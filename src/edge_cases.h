@@ -8,7 +8,7 @@
 
 template<typename T>
 static inline T ieee_nextafter(T x, T y) {
-	if (x == 0.0) {
+	if (x == 0.0 && y == y) {
         if (y == 0.0) {
             // special case where `+0.0 --> -0.0` and `-0.0 --> +0.0`
             return y;
@@ -0,0 +1,106 @@
+#ifndef EDGE_PRODUCT_H
+#define EDGE_PRODUCT_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "random_gen.h"
+#include "stratified_sampler.h"
+#include "table_columns.hpp"
+#include "test_gen.hpp"
+
+/*
+** The cartesian product of the edge case sets of each argument of a
+** table, computed from the row index instead of being materialized, so
+** that any slice of rows can be generated on its own. The first argument
+** varies fastest. The leading rows of a table are the combinations of the
+** product, and the rows after them are random. A table with fewer rows
+** than the product holds an evenly spread subset of the combinations.
+*/
+template<size_t N>
+class Edge_Product {
+public:
+	explicit Edge_Product(const std::array<size_t, N>& sizes) : set_sizes(sizes) {
+		combinations = 1;
+		for (size_t size : set_sizes) {
+			combinations *= size;
+		}
+	}
+
+	size_t size() const {
+		return combinations;
+	}
+
+	/* the combination of a row, or size() for a random row */
+	size_t combination_of(size_t row, size_t table_rows) const {
+		if (table_rows < combinations) {
+			return static_cast<size_t>(
+				static_cast<unsigned __int128>(row) * combinations / table_rows
+			);
+		}
+		return (row < combinations) ? row : combinations;
+	}
+
+	/* the index into each edge case set of a combination */
+	std::array<size_t, N> indices(size_t combination) const {
+		std::array<size_t, N> result;
+		for (size_t k = 0; k < N; k++) {
+			result[k] = combination % set_sizes[k];
+			combination /= set_sizes[k];
+		}
+		return result;
+	}
+
+private:
+	std::array<size_t, N> set_sizes;
+	size_t combinations;
+};
+
+template<typename T, size_t N>
+inline size_t product_size(const std::array<std::span<const T>, N>& sets) {
+	size_t size = 1;
+	for (std::span<const T> set : sets) {
+		size *= set.size();
+	}
+	return size;
+}
+
+/*
+** Fills N float columns from the product of the edge case sets, followed
+** by values of samplers[k] drawn from streams[k] for argument k.
+*/
+template<typename T, size_t N>
+inline void generate_product_input(
+	const Gen_Slice& slice, Record_Columns& input,
+	const std::array<std::span<const T>, N>& sets,
+	const std::array<Random_Stream_Id, N>& streams,
+	const std::array<const Stratified_Sampler<T>*, N>& samplers
+) {
+	std::array<size_t, N> sizes;
+	std::array<std::span<float_bits<T>>, N> columns;
+	std::array<Random_Stream, N> rngs;
+	for (size_t k = 0; k < N; k++) {
+		sizes[k] = sets[k].size();
+		columns[k] = input[k].values<float_bits<T>>();
+		rngs[k] = {slice.seed, streams[k]};
+	}
+	const Edge_Product<N> product(sizes);
+	for (size_t i = slice.begin; i < slice.end; i++) {
+		const size_t row = slice.row(i);
+		const size_t combination = product.combination_of(row, slice.table_rows);
+		if (combination < product.size()) {
+			const std::array<size_t, N> indices = product.indices(combination);
+			for (size_t k = 0; k < N; k++) {
+				columns[k][i] = to_bits(sets[k][indices[k]]);
+			}
+		} else {
+			for (size_t k = 0; k < N; k++) {
+				columns[k][i] = samplers[k]->sample(rngs[k], row);
+			}
+		}
+	}
+}
+
+#endif /* EDGE_PRODUCT_H */
@@ -0,0 +1,191 @@
+#ifndef EXCEPTION_FLAGS_H
+#define EXCEPTION_FLAGS_H
+
+#include <algorithm>
+#include <cfenv>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+
+#if defined(__x86_64__)
+	#include <immintrin.h>
+#endif
+
+#include "table_columns.hpp"
+#include "test_gen.hpp"
+
+/*
+** Exception flag tables add a flags column to the outputs of a table: the
+** floating-point exceptions raised by the evaluation of each row, with the
+** bits below rather than the FE_* values of the host. Testing the flags of
+** every row is slow, so a block of rows is evaluated and tested as a
+** whole, and only blocks that raised something are split into
+** flag_block_fanout parts that are evaluated and tested again, down to
+** single rows. Rows that raise nothing, such as most rows of ilogb or
+** fmin, cost one evaluation. Rows that raise inexact, such as most rows of
+** sqrt, cost three evaluations and a test of their own, which is still
+** less than feclearexcept and fetestexcept around every row.
+*/
+enum Exception_Flag : uint32_t {
+	flag_invalid = 1 << 0,
+	flag_divbyzero = 1 << 1,
+	flag_overflow = 1 << 2,
+	flag_underflow = 1 << 3,
+	flag_inexact = 1 << 4,
+};
+
+/* the bits of the flags column, for the headers of the tables */
+inline constexpr const char* exception_flag_macros =
+	"#ifndef TG_FE_INVALID\n"
+	"#define TG_FE_INVALID   0x01\n"
+	"#define TG_FE_DIVBYZERO 0x02\n"
+	"#define TG_FE_OVERFLOW  0x04\n"
+	"#define TG_FE_UNDERFLOW 0x08\n"
+	"#define TG_FE_INEXACT   0x10\n"
+	"#endif";
+
+/* rows tested at once, and the parts a block that raised something is split into */
+constexpr size_t flag_block_rows = 256;
+constexpr size_t flag_block_fanout = 16;
+
+inline uint32_t exception_flags(int raised) {
+	uint32_t flags = 0;
+	for (auto [fe, flag] : {
+		std::pair{FE_INVALID, flag_invalid}, {FE_DIVBYZERO, flag_divbyzero},
+		{FE_OVERFLOW, flag_overflow}, {FE_UNDERFLOW, flag_underflow}, {FE_INEXACT, flag_inexact}
+	}) {
+		if (raised & fe) {
+			flags |= flag;
+		}
+	}
+	return flags;
+}
+
+/*
+** fetestexcept and feclearexcept for SSE and the x87 separately. On x86,
+** the feclearexcept of glibc stores and reloads the whole x87 environment,
+** which costs more than evaluating most rows. The x87 is only used by
+** long double, and by a few libm functions, so the rows of a block that
+** raised nothing on the x87 only clear and test SSE.
+*/
+#if defined(__x86_64__) && defined(__GNUC__)
+	inline int sse_exceptions() {
+		return static_cast<int>(_mm_getcsr()) & FE_ALL_EXCEPT;
+	}
+
+	inline int x87_exceptions() {
+		uint16_t status;
+		__asm__ volatile ("fnstsw %0" : "=am"(status));
+		return status & FE_ALL_EXCEPT;
+	}
+
+	inline void clear_sse_exceptions() {
+		_mm_setcsr(_mm_getcsr() & ~static_cast<unsigned>(FE_ALL_EXCEPT));
+	}
+
+	inline void clear_x87_exceptions() {
+		__asm__ volatile ("fnclex");
+	}
+#else
+	inline int sse_exceptions() {
+		return std::fetestexcept(FE_ALL_EXCEPT);
+	}
+
+	inline int x87_exceptions() {
+		return 0;
+	}
+
+	inline void clear_sse_exceptions() {
+		std::feclearexcept(FE_ALL_EXCEPT);
+	}
+
+	inline void clear_x87_exceptions() {}
+#endif
+
+/*
+** The flags raised by each of rows [begin, end), splitting blocks that
+** raised any. x87 is false if the rows are known to raise nothing on the x87.
+*/
+template<Evaluate_Function evaluate>
+inline void evaluate_flag_block(
+	const Record_Columns& input, Record_Columns& output, std::span<uint32_t> flags,
+	size_t begin, size_t end, bool x87
+) {
+	clear_sse_exceptions();
+	if (x87) {
+		clear_x87_exceptions();
+	}
+	evaluate(input, output, begin, end);
+	const int x87_raised = x87 ? x87_exceptions() : 0;
+	const int raised = sse_exceptions() | x87_raised;
+	if (raised == 0 || end - begin == 1) {
+		std::fill(flags.begin() + static_cast<ptrdiff_t>(begin),
+			flags.begin() + static_cast<ptrdiff_t>(end), exception_flags(raised));
+		return;
+	}
+	const size_t part = (end - begin + flag_block_fanout - 1) / flag_block_fanout;
+	for (size_t i = begin; i < end; i += part) {
+		evaluate_flag_block<evaluate>(
+			input, output, flags, i, std::min(end, i + part), x87_raised != 0
+		);
+	}
+}
+
+/* restores the exception flags of the calling thread when it goes out of scope */
+class Exception_Flag_Scope {
+public:
+	Exception_Flag_Scope() {
+		std::fegetexceptflag(&saved, FE_ALL_EXCEPT);
+	}
+	Exception_Flag_Scope(const Exception_Flag_Scope&) = delete;
+	Exception_Flag_Scope& operator=(const Exception_Flag_Scope&) = delete;
+
+	~Exception_Flag_Scope() {
+		std::fesetexceptflag(&saved, FE_ALL_EXCEPT);
+	}
+
+private:
+	std::fexcept_t saved;
+};
+
+/*
+** Evaluates rows [begin, end) into the columns before the last, and the
+** exceptions each row raised into the last column. Other slices of the
+** table are evaluated into the same columns concurrently, so the rows are
+** evaluated over a copy into scratch columns, which are copied into rows
+** [begin, end). The exception flags of the calling thread are restored
+** afterwards.
+*/
+template<Evaluate_Function evaluate>
+inline void evaluate_exception_flags(
+	const Record_Columns& input,
+	Record_Columns& output,
+	size_t begin, size_t end
+) {
+	const size_t rows = end - begin;
+	const Record_Columns slice_input = copy_records(input, begin, end);
+	Record_Columns values = scratch_records(output, 0, output.columns.size() - 1, rows);
+	std::span<uint32_t> flags = output.columns.back().values<uint32_t>().subspan(begin, rows);
+	{
+		Exception_Flag_Scope scope;
+		for (size_t i = 0; i < rows; i += flag_block_rows) {
+			evaluate_flag_block<evaluate>(
+				slice_input, values, flags, i, std::min(rows, i + flag_block_rows), true
+			);
+		}
+	}
+	store_records(values, output, 0, begin);
+}
+
+/* the fields of layout followed by flags. A scalar field is named result */
+inline Record_Layout exception_flag_layout(const Record_Layout& layout) {
+	Record_Layout flags = layout;
+	if (flags.is_scalar()) {
+		flags.fields[0].name = "result";
+	}
+	flags.fields.push_back({Field_Kind::u32, "flags"});
+	return flags;
+}
+
+#endif /* EXCEPTION_FLAGS_H */
@@ -0,0 +1,200 @@
+#ifndef EXHAUSTIVE_SWEEP_H
+#define EXHAUSTIVE_SWEEP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "binary_export.h"
+#include "table_cache.hpp"
+#include "table_columns.hpp"
+#include "table_writer.h"
+#include "test_gen.hpp"
+
+/*
+** Exhaustive sweeps evaluate a unary float table over all 2^32 inputs.
+** Rather than storing the outputs, each block of 2^16 consecutive inputs
+** is reduced to a checksum of its outputs, packed as zero padded
+** output_type records (the binary table layout) and hashed with
+** test_gen_bin_hash. A 512 KiB table of checksums certifies every input,
+** and a mismatching block can be bisected against the host on its own.
+*/
+constexpr unsigned sweep_block_bits = 16;
+constexpr size_t sweep_block_size = size_t(1) << sweep_block_bits;
+constexpr size_t sweep_block_count = size_t(1) << (32 - sweep_block_bits);
+/* blocks per job */
+constexpr size_t sweep_job_blocks = 64;
+
+/* tables that take a single float and nothing else */
+template<typename T>
+bool is_unary_table(const Test_Gen<T>& table) {
+	return table.input_layout.size() == 1 && table.input_layout.fields[0].kind == float_kind<T>;
+}
+
+/* reused between the blocks of a job */
+struct Sweep_Buffers {
+	Record_Columns input;
+	Record_Columns output;
+	std::vector<unsigned char> packed;
+
+	Sweep_Buffers(const Record_Layout& input_layout, const Record_Layout& output_layout) :
+		input(input_layout, sweep_block_size),
+		output(output_layout, sweep_block_size),
+		packed(output_layout.record_size() * sweep_block_size)
+	{}
+};
+
+/*
+** computes checksums[block] for blocks [first_block, last_block).
+** @returns false if check is set and evaluate differs from the reference
+*/
+inline bool sweep_blocks(
+	const Test_Gen<float>& table, size_t first_block, size_t last_block,
+	Sweep_Buffers& buffers, uint64_t* checksums, bool check = false
+) {
+	std::span<uint32_t> inputs = buffers.input[0].values<uint32_t>();
+	for (size_t block = first_block; block < last_block; block++) {
+		const uint32_t first = static_cast<uint32_t>(block << sweep_block_bits);
+		for (size_t i = 0; i < sweep_block_size; i++) {
+			inputs[i] = first + static_cast<uint32_t>(i);
+		}
+		table.evaluate(buffers.input, buffers.output, 0, sweep_block_size);
+		if (
+			check &&
+			!table.matches_reference(buffers.input, buffers.output, 0, sweep_block_size)
+		) {
+			return false;
+		}
+		pack_records(buffers.packed.data(), table.output_layout, buffers.output);
+		checksums[block] = hash_bytes(buffers.packed.data(), buffers.packed.size());
+	}
+	return true;
+}
+
+/* a table of a fused sweep, and its checksums */
+struct Fused_Sweep {
+	const Test_Gen<float>& table;
+	uint64_t* checksums;
+	/* compare evaluate against the reference */
+	bool check;
+	/* set if check is set and evaluate differs from the reference */
+	bool mismatch = false;
+};
+
+/*
+** sweep_blocks of several tables at once. The inputs of each block are
+** written once, and evaluated by every table fuse_block_rows at a time.
+** Blocks after a mismatch of a table are not checksummed for that table.
+*/
+inline void sweep_blocks_fused(
+	std::vector<Fused_Sweep>& sweeps, size_t first_block, size_t last_block
+) {
+	if (sweeps.empty()) {
+		return;
+	}
+	Record_Columns input(sweeps.front().table.input_layout, sweep_block_size);
+	std::vector<Record_Columns> outputs;
+	std::vector<unsigned char> packed;
+	for (const Fused_Sweep& sweep : sweeps) {
+		outputs.emplace_back(sweep.table.output_layout, sweep_block_size);
+		packed.resize(std::max(
+			packed.size(), sweep.table.output_layout.record_size() * sweep_block_size
+		));
+	}
+	std::span<uint32_t> inputs = input[0].values<uint32_t>();
+	for (size_t block = first_block; block < last_block; block++) {
+		const uint32_t first = static_cast<uint32_t>(block << sweep_block_bits);
+		for (size_t i = 0; i < sweep_block_size; i++) {
+			inputs[i] = first + static_cast<uint32_t>(i);
+		}
+		for (size_t begin = 0; begin < sweep_block_size; begin += fuse_block_rows) {
+			const size_t end = std::min(sweep_block_size, begin + fuse_block_rows);
+			for (size_t t = 0; t < sweeps.size(); t++) {
+				if (!sweeps[t].mismatch) {
+					sweeps[t].table.evaluate(input, outputs[t], begin, end);
+				}
+			}
+		}
+		for (size_t t = 0; t < sweeps.size(); t++) {
+			Fused_Sweep& sweep = sweeps[t];
+			if (sweep.mismatch) {
+				continue;
+			}
+			if (
+				sweep.check &&
+				!sweep.table.matches_reference(input, outputs[t], 0, sweep_block_size)
+			) {
+				sweep.mismatch = true;
+				continue;
+			}
+			const size_t size = sweep.table.output_layout.record_size() * sweep_block_size;
+			pack_records(packed.data(), sweep.table.output_layout, outputs[t]);
+			sweep.checksums[block] = hash_bytes(packed.data(), size);
+		}
+	}
+}
+
+struct Sweep_Table {
+	/* such as f32_sqrt_LUT, the file is f32_sqrt_LUT_sweep.h */
+	std::string prefix;
+	std::string headers;
+	std::string timestamp;
+	const Record_Layout& output_layout;
+	/* sweep_block_count checksums */
+	const Record_Columns& checksums;
+};
+
+inline Write_Status export_sweep_table(const Sweep_Table& table, Table_Cache* cache, uint64_t key) {
+	const std::string name = table.prefix + "_sweep";
+	const std::string file_name = name + ".h";
+	std::string guard = file_name;
+	std::transform(guard.begin(), guard.end(), guard.begin(), ::toupper);
+	std::replace(guard.begin(), guard.end(), '.', '_');
+	std::string macro = name;
+	std::transform(macro.begin(), macro.end(), macro.begin(), ::toupper);
+
+	std::string head;
+	head += "#ifndef " + guard + "\n";
+	head += "#define " + guard + "\n\n";
+	head += table.headers + "\n";
+	head += "#include \"" + std::string(binary_loader_file_name) + "\"\n\n";
+	const size_t timestamp_begin = head.size();
+	head += "/* Generated " + table.timestamp + " */\n\n";
+	const size_t timestamp_end = head.size();
+	head += "/*\n";
+	head += "** Entry i is test_gen_bin_hash(outputs, size, 0) of the outputs for the\n";
+	head += "** inputs (i << " + macro + "_BLOCK_BITS) onwards, stored as zero padded\n";
+	head += "** output records. Every 32bit input pattern is covered.\n";
+	head += "*/\n";
+	head += "#define " + macro + "_BLOCK_BITS " + std::to_string(sweep_block_bits) + "\n\n";
+	head += binary_record_typedef(table.output_layout, name + "_output_type") + "\n";
+	head += "const uint64_t " + name + "[" + std::to_string(sweep_block_count) + "] = {\n";
+
+	std::string tail;
+	tail += "};\n\n";
+	tail += "/* @returns 0 if the outputs for the inputs of block match */\n";
+	tail += "static inline int " + name + "_check(\n";
+	tail += "\tuint32_t block, const " + name + "_output_type* outputs\n";
+	tail += ") {\n";
+	tail += "\tconst size_t size = sizeof(*outputs) << " + macro + "_BLOCK_BITS;\n";
+	tail += "\treturn (test_gen_bin_hash(outputs, size, 0) == " + name + "[block]) ? 0 : -1;\n";
+	tail += "}\n\n";
+	tail += "#endif /* " + guard + " */\n";
+
+	const size_t file_size = head.size() + records_text_length(table.checksums) + tail.size();
+	Write_Status status = write_cached_file(
+		cache, file_name, key, table.timestamp, file_size, timestamp_begin, timestamp_end,
+		[&](char* dst) {
+			std::memcpy(dst, head.data(), head.size());
+			dst = write_records_text(dst + head.size(), table.checksums);
+			std::memcpy(dst, tail.data(), tail.size());
+		}
+	);
+	print_write_status(status, file_name);
+	return status;
+}
+
+#endif /* EXHAUSTIVE_SWEEP_H */
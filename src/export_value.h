@@ -3,9 +3,13 @@
 
 #include <string>
 #include <bit>
+#include <charconv>
 #include <cinttypes>
 #include <cstring>
 
+#include "hex_encode.h"
+#include "table_columns.hpp"
+
 template<typename T>
 std::string export_value(const T& value);
 
@@ -16,63 +20,105 @@ inline std::string export_value(const std::string& value) {
 
 template<>
 inline std::string export_value(const double& value) {
-	std::string ret;
-	char buf[256];
-	std::memset(buf, '\0', sizeof(buf));
-	snprintf(buf, sizeof(buf), "UINT64_C(0x%016" PRIX64 ")", std::bit_cast<uint64_t>(value));
-	ret.assign(buf);
-	return ret;
+	char buf[32];
+	char* end = encode_hex_literal(buf, std::bit_cast<uint64_t>(value), "UINT64_C");
+	return std::string(buf, end);
 }
 
 template<>
 inline std::string export_value(const uint64_t& value) {
-	std::string ret;
-	char buf[256];
-	std::memset(buf, '\0', sizeof(buf));
-	snprintf(buf, sizeof(buf), "UINT64_C(0x%016" PRIX64 ")", value);
-	ret.assign(buf);
-	return ret;
+	char buf[32];
+	char* end = encode_hex_literal(buf, value, "UINT64_C");
+	return std::string(buf, end);
 }
 
 template<>
 inline std::string export_value(const int64_t& value) {
-	std::string ret;
-	char buf[256];
-	std::memset(buf, '\0', sizeof(buf));
-	snprintf(buf, sizeof(buf), "INT64_C(0x%016" PRIX64 ")", value);
-	ret.assign(buf);
-	return ret;
+	char buf[32];
+	char* end = encode_hex_literal(buf, static_cast<uint64_t>(value), "INT64_C");
+	return std::string(buf, end);
 }
 
 template<>
 inline std::string export_value(const float& value) {
-	std::string ret;
-	char buf[256];
-	std::memset(buf, '\0', sizeof(buf));
-	snprintf(buf, sizeof(buf), "UINT32_C(0x%08" PRIX32 ")", std::bit_cast<uint32_t>(value));
-	ret.assign(buf);
-	return ret;
+	char buf[32];
+	char* end = encode_hex_literal(buf, std::bit_cast<uint32_t>(value), "UINT32_C");
+	return std::string(buf, end);
 }
 
 template<>
 inline std::string export_value(const uint32_t& value) {
-	std::string ret;
-	char buf[256];
-	std::memset(buf, '\0', sizeof(buf));
-	snprintf(buf, sizeof(buf), "UINT32_C(0x%08" PRIX32 ")", value);
-	ret.assign(buf);
-	return ret;
+	char buf[32];
+	char* end = encode_hex_literal(buf, value, "UINT32_C");
+	return std::string(buf, end);
 }
 
 template<>
 inline std::string export_value(const int32_t& value) {
-	std::string ret;
-	char buf[256];
-	std::memset(buf, '\0', sizeof(buf));
-	snprintf(buf, sizeof(buf), "INT32_C(0x%08" PRIX32 ")", value);
-	ret.assign(buf);
-	return ret;
+	char buf[32];
+	char* end = encode_hex_literal(buf, static_cast<uint32_t>(value), "INT32_C");
+	return std::string(buf, end);
+}
+
+/* hex literal macro of a field, or nullptr for fields exported in decimal */
+inline const char* field_literal_macro(Field_Kind kind) {
+	switch (kind) {
+		case Field_Kind::f32: return "UINT32_C";
+		case Field_Kind::u32: return "UINT32_C";
+		case Field_Kind::i32: return "INT32_C";
+		case Field_Kind::f64: return "UINT64_C";
+		case Field_Kind::u64: return "UINT64_C";
+		case Field_Kind::i64: return "INT64_C";
+		case Field_Kind::int_dec: return nullptr;
+		case Field_Kind::expon: return nullptr;
+	}
+	return nullptr;
+}
+
+inline size_t field_hex_digits(Field_Kind kind) {
+	return field_is_wide(kind) ? 16 : 8;
+}
+
+inline const char* expon_symbol(int64_t expon) {
+	switch (expon) {
+		case expon_int_max: return "INT_MAX";
+		case expon_ilogbnan: return "FP_ILOGBNAN";
+		case expon_ilogb0: return "FP_ILOGB0";
+		default: return nullptr;
+	}
+}
+
+/* writes an int_dec or expon field. @returns a pointer past the end of the text */
+inline char* write_decimal_field(char* dst, const Column& column, size_t i) {
+	int64_t value = (column.field.kind == Field_Kind::expon) ?
+		static_cast<int64_t>(column.raw(i)) :
+		static_cast<int32_t>(column.raw(i));
+	const char* symbol = (column.field.kind == Field_Kind::expon) ? expon_symbol(value) : nullptr;
+	if (symbol != nullptr) {
+		size_t len = strlen(symbol);
+		std::memcpy(dst, symbol, len);
+		return dst + len;
+	}
+	return std::to_chars(dst, dst + 24, value).ptr;
 }
 
+inline size_t decimal_field_length(const Column& column, size_t i) {
+	char buf[24];
+	return static_cast<size_t>(write_decimal_field(buf, column, i) - buf);
+}
+
+inline std::string export_field(const Column& column, size_t i) {
+	char buf[32];
+	const char* macro = field_literal_macro(column.field.kind);
+	char* end;
+	if (macro == nullptr) {
+		end = write_decimal_field(buf, column, i);
+	} else if (field_is_wide(column.field.kind)) {
+		end = encode_hex_literal(buf, column.raw(i), macro);
+	} else {
+		end = encode_hex_literal(buf, static_cast<uint32_t>(column.raw(i)), macro);
+	}
+	return std::string(buf, end);
+}
 
 #endif /* EXPORT_VALUE_H */
@@ -0,0 +1,591 @@
+#ifndef HALF_TABLES_H
+#define HALF_TABLES_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <span>
+#include <string>
+#include <vector>
+#include <math.h>
+
+#include "binary_export.h"
+#include "correct_round.h"
+#include "export_value.h"
+#include "options.h"
+#include "table_cache.hpp"
+#include "table_columns.hpp"
+#include "table_writer.h"
+#include "test_gen.hpp"
+
+/*
+** Tables of the 16bit formats binary16 (_Float16) and bfloat16. With only
+** 65536 inputs, unary tables are exhaustive and dense: element x of
+** f16_exp_dense is the result for the input with bit pattern x, so no
+** input array is stored. Binary functions have 2^32 pairs, which are swept
+** with --exhaustive in tiles of 256 by 256 pairs, each reduced to a
+** checksum. Results are computed from the inputs widened to float, with
+** the Ziv oracle of correct_round.h rounding straight from the wide
+** format to 16 bits, so results are not rounded twice through float.
+** The exact unary functions, such as floor or frexp, reuse the evaluators
+** of the f32 and f64 tables.
+*/
+
+struct Binary16 {
+	static constexpr const char* name = "f16";
+	static constexpr unsigned type = type_f16;
+	/* significand bits, including the implicit bit */
+	static constexpr int digits = 11;
+	static constexpr int exponent_bits = 5;
+};
+
+struct BFloat16 {
+	static constexpr const char* name = "bf16";
+	static constexpr unsigned type = type_bf16;
+	static constexpr int digits = 8;
+	static constexpr int exponent_bits = 8;
+};
+
+template<typename Format>
+struct Half_Layout {
+	static constexpr int mant_bits = Format::digits - 1;
+	static constexpr int bias = (1 << (Format::exponent_bits - 1)) - 1;
+	/* exponents of the smallest and largest normal values */
+	static constexpr int min_exponent = 1 - bias;
+	static constexpr int max_exponent = bias;
+	static constexpr uint16_t sign_mask = 0x8000;
+	static constexpr uint16_t exponent_mask =
+		static_cast<uint16_t>(((1 << Format::exponent_bits) - 1) << mant_bits);
+	static constexpr uint16_t mant_mask = static_cast<uint16_t>((1 << mant_bits) - 1);
+	static constexpr uint16_t quiet_bit = static_cast<uint16_t>(1 << (mant_bits - 1));
+};
+
+/* the value of bits, exactly. NaNs keep their payload, and signaling NaNs stay signaling */
+template<typename Format>
+inline float half_to_float(uint16_t bits) {
+	using L = Half_Layout<Format>;
+	const uint32_t sign = static_cast<uint32_t>(bits & L::sign_mask) << 16;
+	const int biased = (bits & L::exponent_mask) >> L::mant_bits;
+	const uint32_t mant = bits & L::mant_mask;
+	if (biased == (L::exponent_mask >> L::mant_bits)) {
+		return from_bits<float>(sign | 0x7F800000 | (mant << (23 - L::mant_bits)));
+	}
+	float magnitude;
+	if (biased == 0) {
+		magnitude = std::ldexp(static_cast<float>(mant), L::min_exponent - L::mant_bits);
+	} else {
+		magnitude = std::ldexp(
+			static_cast<float>(mant | (1u << L::mant_bits)), biased - L::bias - L::mant_bits
+		);
+	}
+	return sign ? -magnitude : magnitude;
+}
+
+/* operations of the formats the oracle evaluates in */
+inline int wide_ilogb(double x) { return std::ilogb(x); }
+inline int wide_ilogb(long double x) { return std::ilogb(x); }
+inline double wide_scalbn(double x, int n) { return std::scalbn(x, n); }
+inline long double wide_scalbn(long double x, int n) { return std::scalbn(x, n); }
+inline double wide_nearbyint(double x) { return std::nearbyint(x); }
+inline long double wide_nearbyint(long double x) { return std::nearbyint(x); }
+inline bool wide_signbit(double x) { return std::signbit(x); }
+inline bool wide_signbit(long double x) { return std::signbit(x); }
+
+#ifdef TEST_GEN_QUADMATH
+inline int wide_ilogb(__float128 x) { return ilogbq(x); }
+inline __float128 wide_scalbn(__float128 x, int n) { return scalbnq(x, n); }
+inline __float128 wide_nearbyint(__float128 x) { return nearbyintq(x); }
+inline bool wide_signbit(__float128 x) { return signbitq(x) != 0; }
+#endif
+
+/*
+** |y| split into an integer significand in units of the quantum of the
+** format at its exponent, before rounding. @returns the exponent of the quantum
+*/
+template<typename Format, typename W>
+inline int half_significand(W magnitude, W& significand) {
+	using L = Half_Layout<Format>;
+	const int expon = std::max(wide_ilogb(magnitude), L::min_exponent);
+	significand = wide_scalbn(magnitude, L::mant_bits - expon);
+	return expon - L::mant_bits;
+}
+
+/* y rounded to nearest, ties to even */
+template<typename Format, typename W>
+inline uint16_t round_to_half(W y) {
+	using L = Half_Layout<Format>;
+	const uint16_t sign = wide_signbit(y) ? L::sign_mask : 0;
+	if (y != y) {
+		/* quiet, keeping the leading bits of the payload */
+		const uint32_t bits = to_bits(static_cast<float>(y));
+		return static_cast<uint16_t>(
+			sign | L::exponent_mask | L::quiet_bit | ((bits & 0x7FFFFF) >> (23 - L::mant_bits))
+		);
+	}
+	const W magnitude = sign ? -y : y;
+	if (magnitude - magnitude != 0) {
+		return sign | L::exponent_mask;
+	}
+	if (magnitude == 0) {
+		return sign;
+	}
+	W significand;
+	int quantum = half_significand<Format>(magnitude, significand);
+	uint32_t mant = static_cast<uint32_t>(wide_nearbyint(significand));
+	if (mant >> Format::digits) {
+		/* rounded up to the next power of two */
+		mant >>= 1;
+		quantum++;
+	}
+	if (mant < (1u << L::mant_bits)) {
+		/* subnormal, or zero */
+		return static_cast<uint16_t>(sign | mant);
+	}
+	const int biased = quantum + L::mant_bits + L::bias;
+	if (biased > L::max_exponent + L::bias) {
+		return sign | L::exponent_mask;
+	}
+	return static_cast<uint16_t>(
+		sign | (biased << L::mant_bits) | (mant & L::mant_mask)
+	);
+}
+
+/* whether y lies exactly halfway between two values of the format */
+template<typename Format, typename W>
+inline bool is_half_midpoint(W y) {
+	const W magnitude = (y < 0) ? -y : y;
+	if (magnitude - magnitude != 0 || magnitude == 0) {
+		return false;
+	}
+	W significand;
+	half_significand<Format>(magnitude, significand);
+	const W fraction = significand - wide_nearbyint(significand);
+	return fraction == static_cast<W>(0.5) || fraction == static_cast<W>(-0.5);
+}
+
+template<typename Format, typename W>
+inline bool round_half_unambiguous(W y, uint16_t& result) {
+	result = round_to_half<Format>(y);
+	if (!(y - y == 0)) {
+		return true;
+	}
+	const W magnitude = (y < 0) ? -y : y;
+	const W error = (magnitude * Oracle_Format<W>::epsilon + Oracle_Format<W>::denorm_min) *
+		static_cast<W>(oracle_error_ulps + 1);
+	/* as values, so that -0 and +0 are the same */
+	auto same = [&](uint16_t bits) {
+		return bits == result || ((bits | result) & ~Half_Layout<Format>::sign_mask) == 0;
+	};
+	return same(round_to_half<Format>(y - error)) && same(round_to_half<Format>(y + error));
+}
+
+/* function(args...) rounded to nearest, ties to even, where args are values of the format */
+template<typename Format, size_t arity, typename... Args>
+inline uint16_t correctly_rounded_half(const Oracle_Function<arity>& function, Args... args) {
+	if constexpr (arity != 1) {
+		/* pow(sNaN, 0) is NaN, unlike pow(qNaN, 0) */
+		for (float x : {args...}) {
+			if (is_signaling_nan(x)) {
+				return round_to_half<Format>(static_cast<double>(x));
+			}
+		}
+	}
+	uint16_t result = 0;
+	if (round_half_unambiguous<Format>(function.template evaluate<double>(args...), result)) {
+		return result;
+	}
+	oracle_escalations++;
+	const long double extended = function.template evaluate<long double>(args...);
+	if (round_half_unambiguous<Format>(extended, result)) {
+		return result;
+	}
+	if (function.f128 != nullptr) {
+		const oracle_quad y = function.template evaluate<oracle_quad>(args...);
+		if (round_half_unambiguous<Format>(y, result) || is_half_midpoint<Format>(y)) {
+			return result;
+		}
+	} else if (is_half_midpoint<Format>(extended)) {
+		return result;
+	}
+	oracle_unresolved++;
+	return result;
+}
+
+#ifdef TEST_GEN_QUADMATH
+#define HALF_QUAD(name) name##q
+#else
+#define HALF_QUAD(name) nullptr
+#endif
+
+/* sqrt and the correctly rounded functions of the wider tables */
+inline std::vector<Oracle_Function<1>> half_unary_functions() {
+	std::vector<Oracle_Function<1>> functions = {{"sqrt", ::sqrt, ::sqrtl, HALF_QUAD(sqrt)}};
+	functions.insert(functions.end(), oracle_functions.begin(), oracle_functions.end());
+	return functions;
+}
+
+#undef HALF_QUAD
+
+/*
+** The unary tables whose results for a 16bit input are exact in the 16bit
+** format, by the float type of the table. Those results are the results of
+** the table over the input widened to float or double, so they are
+** computed by the evaluator of the table, and only its float fields are
+** narrowed to 16 bits. Other fields, such as the exponent of frexp or the
+** u64 of to_integer, keep the kind of the table.
+*/
+inline constexpr std::array<const char*, 7> exact_dense_f32_tables = {
+	"ilogb_LUT", "logb_LUT", "frexp_LUT", "to_f64_LUT", "modf_LUT", "rounding_LUT",
+	"to_integer_LUT"
+};
+inline constexpr std::array<const char*, 1> exact_dense_f64_tables = {"to_f32_LUT"};
+
+template<typename T>
+struct Exact_Dense_Function {
+	/* such as frexp, for frexp_LUT */
+	std::string name;
+	const Test_Gen<T>* table;
+};
+
+/* the tables of Test_List named by table_names */
+template<typename T>
+inline std::vector<Exact_Dense_Function<T>> exact_dense_functions(
+	const std::vector<Test_Gen<T>>& Test_List, std::span<const char* const> table_names
+) {
+	std::vector<Exact_Dense_Function<T>> functions;
+	for (const char* table_name : table_names) {
+		for (const Test_Gen<T>& table : Test_List) {
+			if (table.table_name == table_name) {
+				const size_t suffix = table.table_name.size() - std::strlen("_LUT");
+				functions.push_back({table.table_name.substr(0, suffix), &table});
+			}
+		}
+	}
+	return functions;
+}
+
+/* fields of the float type of the table, which are narrowed to 16 bits */
+template<typename T>
+inline bool is_narrowed_field(const Field& field) {
+	return field.kind == float_kind<T>;
+}
+
+/*
+** Binary sweeps: tile t covers the pairs (x, y) with x >> tile_bits equal
+** to t >> tile_bits and y >> tile_bits equal to t & (tile_side - 1). Its results
+** are ordered by x, then y, and hashed with test_gen_bin_hash.
+*/
+constexpr unsigned tile_bits = 8;
+constexpr size_t tile_side = size_t(1) << tile_bits;
+constexpr size_t tile_count = size_t(1) << (32 - 2 * tile_bits);
+/* tiles per job */
+constexpr size_t sweep_job_tiles = 256;
+
+/* tables are dense, or the checksums of a sweep of a binary function */
+inline constexpr const char* dense_kind = "dense";
+inline constexpr const char* sweep_kind = "sweep";
+
+/* such as f16_sqrt_dense or bf16_pow_sweep */
+template<typename Format>
+inline std::string half_table_prefix(const char* function, const char* kind) {
+	return std::string(Format::name) + "_" + function + "_" + kind;
+}
+
+/* whether a --table name, such as sqrt, sqrt_dense or f16_sqrt_dense, names the table */
+template<typename Format>
+inline bool half_table_matches(const char* function, const char* kind, const std::string& name) {
+	return name == function || name == std::string(function) + "_" + kind ||
+		name == half_table_prefix<Format>(function, kind);
+}
+
+template<typename Format>
+inline bool half_table_selected(
+	const char* function, const char* kind, const Gen_Options& options
+) {
+	if ((options.types & Format::type) == 0) {
+		return false;
+	}
+	return options.tables.empty() || std::any_of(
+		options.tables.begin(), options.tables.end(),
+		[&](const std::string& name) { return half_table_matches<Format>(function, kind, name); }
+	);
+}
+
+/* whether name names a table of either format, given the functions of the dense tables */
+inline bool is_half_table_name(
+	const std::vector<std::string>& dense_functions, const std::string& name
+) {
+	auto matches = [&](const char* function, const char* kind) {
+		return half_table_matches<Binary16>(function, kind, name) ||
+			half_table_matches<BFloat16>(function, kind, name);
+	};
+	return std::any_of(
+		dense_functions.begin(), dense_functions.end(),
+		[&](const std::string& function) { return matches(function.c_str(), dense_kind); }
+	) || std::any_of(
+		oracle_binary_functions.begin(), oracle_binary_functions.end(),
+		[&](const Oracle_Function<2>& function) { return matches(function.name, sweep_kind); }
+	);
+}
+
+/* everything that determines the contents of a table */
+template<typename Format>
+inline uint64_t half_table_key(const char* function, const char* kind) {
+	uint64_t key = hash_value(test_gen_version);
+	key = hash_string(half_table_prefix<Format>(function, kind), key);
+	if (std::strcmp(kind, sweep_kind) == 0) {
+		key = hash_value(tile_bits, key);
+	}
+	return hash_value(libm_fingerprint(), key);
+}
+
+template<size_t arity>
+inline const char* dense_function_name(const Oracle_Function<arity>& function) {
+	return function.name;
+}
+
+template<typename T>
+inline const char* dense_function_name(const Exact_Dense_Function<T>& function) {
+	return function.name.c_str();
+}
+
+template<typename Format, size_t arity>
+inline uint64_t dense_function_key(const Oracle_Function<arity>& function, const char* kind) {
+	return half_table_key<Format>(function.name, kind);
+}
+
+/* an exact table also depends on the fields and headers of the table computing it */
+template<typename Format, typename T>
+inline uint64_t dense_function_key(const Exact_Dense_Function<T>& function, const char* kind) {
+	uint64_t key = half_table_key<Format>(function.name.c_str(), kind);
+	key = hash_value(sizeof(T), key);
+	key = hash_string(function.table->output_layout.c_type(), key);
+	return hash_string(function.table->headers, key);
+}
+
+/* the result for every input, by bit pattern */
+template<typename Format>
+inline std::vector<uint16_t> dense_unary_results(const Oracle_Function<1>& function) {
+	std::vector<uint16_t> results(size_t(1) << 16);
+	for (size_t x = 0; x < results.size(); x++) {
+		const float value = half_to_float<Format>(static_cast<uint16_t>(x));
+		results[x] = correctly_rounded_half<Format>(function, value);
+	}
+	return results;
+}
+
+/*
+** header text of count values, per_line to a line, each line starting with
+** the index of its first. write_value(text, i) appends value i
+*/
+template<typename Write_Value>
+inline std::string dense_values_text(size_t count, size_t per_line, Write_Value write_value) {
+	std::string text;
+	text.reserve(count * 8 + count / per_line * 16);
+	char buf[32];
+	for (size_t i = 0; i < count; i++) {
+		if (i % per_line == 0) {
+			snprintf(buf, sizeof(buf), "/* 0x%04zX */", i);
+			text += buf;
+		}
+		text += " ";
+		write_value(text, i);
+		text += ",";
+		if (i % per_line == per_line - 1 || i + 1 == count) {
+			text += "\n";
+		}
+	}
+	return text;
+}
+
+inline void append_half(std::string& text, uint16_t value) {
+	char buf[8];
+	snprintf(buf, sizeof(buf), "0x%04X", static_cast<unsigned>(value));
+	text += buf;
+}
+
+template<typename Format>
+inline Write_Status export_dense_table(
+	const char* function, const std::vector<uint16_t>& results, const std::string& timestamp,
+	Table_Cache* cache, uint64_t key
+) {
+	const std::string name = half_table_prefix<Format>(function, dense_kind);
+	const std::string file_name = name + ".h";
+	std::string guard = file_name;
+	std::transform(guard.begin(), guard.end(), guard.begin(), ::toupper);
+	std::replace(guard.begin(), guard.end(), '.', '_');
+
+	std::string text;
+	text += "#ifndef " + guard + "\n";
+	text += "#define " + guard + "\n\n";
+	text += "#include <stdint.h>\n\n";
+	const size_t timestamp_begin = text.size();
+	text += "/* Generated " + timestamp + " */\n\n";
+	const size_t timestamp_end = text.size();
+	text += "/* element x is " + std::string(function) + " of the " + Format::name +
+		" value with bit pattern x, correctly rounded */\n";
+	text += "const uint16_t " + name + "[" + std::to_string(results.size()) + "] = {\n";
+	text += dense_values_text(results.size(), 8, [&](std::string& values, size_t i) {
+		append_half(values, results[i]);
+	});
+	text += "};\n\n";
+	text += "#endif /* " + guard + " */\n";
+
+	Write_Status status = write_cached_file(
+		cache, file_name, key, timestamp, text.size(), timestamp_begin, timestamp_end,
+		[&](char* dst) {
+			std::memcpy(dst, text.data(), text.size());
+		}
+	);
+	print_write_status(status, file_name);
+	return status;
+}
+
+/* the outputs of the table of function for every input, by bit pattern */
+template<typename Format, typename T>
+inline Record_Columns exact_dense_results(const Exact_Dense_Function<T>& function) {
+	const size_t count = size_t(1) << 16;
+	Record_Columns input({{float_kind<T>}}, count);
+	auto x = input[0].values<float_bits<T>>();
+	for (size_t i = 0; i < count; i++) {
+		x[i] = to_bits(static_cast<T>(half_to_float<Format>(static_cast<uint16_t>(i))));
+	}
+	Record_Columns output(function.table->output_layout, count);
+	function.table->evaluate(input, output, 0, count);
+	return output;
+}
+
+/* one array per field of outputs, such as f16_frexp_dense_frac and f16_frexp_dense_expon */
+template<typename Format, typename T>
+inline Write_Status export_exact_dense_table(
+	const Exact_Dense_Function<T>& function, const Record_Columns& outputs,
+	const std::string& timestamp, Table_Cache* cache, uint64_t key
+) {
+	const std::string name = half_table_prefix<Format>(function.name.c_str(), dense_kind);
+	const std::string file_name = name + ".h";
+	std::string guard = file_name;
+	std::transform(guard.begin(), guard.end(), guard.begin(), ::toupper);
+	std::replace(guard.begin(), guard.end(), '.', '_');
+
+	std::string text;
+	text += "#ifndef " + guard + "\n";
+	text += "#define " + guard + "\n\n";
+	text += function.table->headers + "\n\n";
+	const size_t timestamp_begin = text.size();
+	text += "/* Generated " + timestamp + " */\n\n";
+	const size_t timestamp_end = text.size();
+	text += "/* element x of each array is " + function.name + " of the " + Format::name +
+		" value with bit pattern x */\n";
+	for (const Column& column : outputs.columns) {
+		const bool narrowed = is_narrowed_field<T>(column.field);
+		const std::string array = (column.field.name == nullptr) ?
+			name : name + "_" + column.field.name;
+		text += std::string("const ") + (narrowed ? "uint16_t" : field_c_type(column.field.kind)) +
+			" " + array + "[" + std::to_string(outputs.count) + "] = {\n";
+		text += dense_values_text(
+			outputs.count, narrowed ? 8 : 4, [&](std::string& values, size_t i) {
+				if (narrowed) {
+					const T value = from_bits<T>(static_cast<float_bits<T>>(column.raw(i)));
+					append_half(values, round_to_half<Format>(static_cast<double>(value)));
+				} else {
+					values += export_field(column, i);
+				}
+			}
+		);
+		text += "};\n\n";
+	}
+	text += "#endif /* " + guard + " */\n";
+
+	Write_Status status = write_cached_file(
+		cache, file_name, key, timestamp, text.size(), timestamp_begin, timestamp_end,
+		[&](char* dst) {
+			std::memcpy(dst, text.data(), text.size());
+		}
+	);
+	print_write_status(status, file_name);
+	return status;
+}
+
+/* computes checksums[tile] for tiles [first_tile, last_tile) */
+template<typename Format>
+inline void sweep_tiles(
+	const Oracle_Function<2>& function, size_t first_tile, size_t last_tile, uint64_t* checksums
+) {
+	std::vector<float> xs(tile_side);
+	std::vector<float> ys(tile_side);
+	std::vector<uint16_t> results(tile_side * tile_side);
+	for (size_t tile = first_tile; tile < last_tile; tile++) {
+		const size_t x_base = (tile >> tile_bits) << tile_bits;
+		const size_t y_base = (tile & (tile_side - 1)) << tile_bits;
+		for (size_t i = 0; i < tile_side; i++) {
+			xs[i] = half_to_float<Format>(static_cast<uint16_t>(x_base + i));
+			ys[i] = half_to_float<Format>(static_cast<uint16_t>(y_base + i));
+		}
+		for (size_t i = 0; i < tile_side; i++) {
+			for (size_t j = 0; j < tile_side; j++) {
+				results[i * tile_side + j] = correctly_rounded_half<Format>(function, xs[i], ys[j]);
+			}
+		}
+		checksums[tile] = hash_bytes(results.data(), results.size() * sizeof(uint16_t));
+	}
+}
+
+template<typename Format>
+inline Write_Status export_tile_sweep(
+	const char* function, const Record_Columns& checksums, const std::string& timestamp,
+	Table_Cache* cache, uint64_t key
+) {
+	const std::string name = half_table_prefix<Format>(function, sweep_kind);
+	const std::string file_name = name + ".h";
+	std::string guard = file_name;
+	std::transform(guard.begin(), guard.end(), guard.begin(), ::toupper);
+	std::replace(guard.begin(), guard.end(), '.', '_');
+	std::string macro = name;
+	std::transform(macro.begin(), macro.end(), macro.begin(), ::toupper);
+
+	std::string head;
+	head += "#ifndef " + guard + "\n";
+	head += "#define " + guard + "\n\n";
+	head += "#include \"" + std::string(binary_loader_file_name) + "\"\n\n";
+	const size_t timestamp_begin = head.size();
+	head += "/* Generated " + timestamp + " */\n\n";
+	const size_t timestamp_end = head.size();
+	head += "/*\n";
+	head += "** Entry t is test_gen_bin_hash(results, size, 0) of the uint16_t results of\n";
+	head += "** " + std::string(function) + "(x, y) for x from (t >> " + macro +
+		"_TILE_BITS) << " + macro + "_TILE_BITS\n";
+	head += "** and y from (t & " + macro + "_TILE_MASK) << " + macro + "_TILE_BITS, ordered by\n";
+	head += "** x then y. Every pair of " + std::string(Format::name) +
+		" bit patterns is covered.\n";
+	head += "*/\n";
+	head += "#define " + macro + "_TILE_BITS " + std::to_string(tile_bits) + "\n";
+	head += "#define " + macro + "_TILE_MASK " + std::to_string(tile_side - 1) + "\n\n";
+	head += "const uint64_t " + name + "[" + std::to_string(tile_count) + "] = {\n";
+
+	std::string tail;
+	tail += "};\n\n";
+	tail += "/* @returns 0 if the results for the pairs of tile match */\n";
+	tail += "static inline int " + name + "_check(uint32_t tile, const uint16_t* results) {\n";
+	tail += "\tconst size_t size = sizeof(*results) << (2 * " + macro + "_TILE_BITS);\n";
+	tail += "\treturn (test_gen_bin_hash(results, size, 0) == " + name + "[tile]) ? 0 : -1;\n";
+	tail += "}\n\n";
+	tail += "#endif /* " + guard + " */\n";
+
+	const size_t file_size = head.size() + records_text_length(checksums) + tail.size();
+	Write_Status status = write_cached_file(
+		cache, file_name, key, timestamp, file_size, timestamp_begin, timestamp_end,
+		[&](char* dst) {
+			std::memcpy(dst, head.data(), head.size());
+			dst = write_records_text(dst + head.size(), checksums);
+			std::memcpy(dst, tail.data(), tail.size());
+		}
+	);
+	print_write_status(status, file_name);
+	return status;
+}
+
+#endif /* HALF_TABLES_H */
@@ -0,0 +1,212 @@
+#ifndef HEX_ENCODE_H
+#define HEX_ENCODE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+#ifdef __AVX2__
+	#include <immintrin.h>
+#endif
+
+/*
+** Writes integer literals such as `UINT64_C(0x0123456789ABCDEF)` into a
+** caller owned buffer. Literal i of a batch is written to dst + i * stride,
+** so a batch can be packed (stride == literal length) or written straight
+** into fixed width rows.
+*/
+
+constexpr std::array<char, 512> hex_byte_table = [] {
+	constexpr char digits[] = "0123456789ABCDEF";
+	std::array<char, 512> table{};
+	for (size_t i = 0; i < 256; i++) {
+		table[2 * i + 0] = digits[i >> 4];
+		table[2 * i + 1] = digits[i & 0xF];
+	}
+	return table;
+}();
+
+/* `macro(0x` + digits + `)` */
+inline size_t hex_literal_length(const char* macro, size_t digits) {
+	return strlen(macro) + 3 + digits + 1;
+}
+
+inline void hex_digits_u32(char* dst, uint32_t value) {
+	for (size_t i = 0; i < 4; i++) {
+		std::memcpy(dst + 2 * (3 - i), &hex_byte_table[2 * (value & 0xFF)], 2);
+		value >>= 8;
+	}
+}
+
+inline void hex_digits_u64(char* dst, uint64_t value) {
+	hex_digits_u32(dst + 0, static_cast<uint32_t>(value >> 32));
+	hex_digits_u32(dst + 8, static_cast<uint32_t>(value));
+}
+
+/* @returns a pointer past the end of the literal */
+inline char* encode_hex_literal(char* dst, uint32_t value, const char* macro) {
+	size_t macro_len = strlen(macro);
+	std::memcpy(dst, macro, macro_len);
+	dst += macro_len;
+	std::memcpy(dst, "(0x", 3);
+	hex_digits_u32(dst + 3, value);
+	dst[3 + 8] = ')';
+	return dst + 3 + 8 + 1;
+}
+
+inline char* encode_hex_literal(char* dst, uint64_t value, const char* macro) {
+	size_t macro_len = strlen(macro);
+	std::memcpy(dst, macro, macro_len);
+	dst += macro_len;
+	std::memcpy(dst, "(0x", 3);
+	hex_digits_u64(dst + 3, value);
+	dst[3 + 16] = ')';
+	return dst + 3 + 16 + 1;
+}
+
+namespace hex_encode_detail {
+
+/* writes `macro(0x` and `)` around every literal, leaving the digits to the caller */
+inline size_t write_frames(
+	size_t count, const char* macro, size_t digits, char* dst, size_t stride
+) {
+	size_t macro_len = strlen(macro);
+	char frame[32];
+	std::memcpy(frame, macro, macro_len);
+	std::memcpy(frame + macro_len, "(0x", 3);
+	size_t head_len = macro_len + 3;
+	for (size_t i = 0; i < count; i++) {
+		char* literal = dst + i * stride;
+		std::memcpy(literal, frame, head_len);
+		literal[head_len + digits] = ')';
+	}
+	return head_len;
+}
+
+#ifdef __AVX2__
+
+inline __m256i nibbles_to_hex(__m256i nibbles) {
+	const __m256i lut = _mm256_setr_epi8(
+		'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F',
+		'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'
+	);
+	return _mm256_shuffle_epi8(lut, nibbles);
+}
+
+/* big endian bytes of v, spread into interleaved (high, low) hex digit pairs */
+inline void bytes_to_hex(__m256i v, __m256i& lo_half, __m256i& hi_half) {
+	const __m256i mask = _mm256_set1_epi8(0x0F);
+	__m256i hi = nibbles_to_hex(_mm256_and_si256(_mm256_srli_epi16(v, 4), mask));
+	__m256i lo = nibbles_to_hex(_mm256_and_si256(v, mask));
+	lo_half = _mm256_unpacklo_epi8(hi, lo);
+	hi_half = _mm256_unpackhi_epi8(hi, lo);
+}
+
+inline size_t digits_u32_avx2(const uint32_t* src, size_t count, char* dst, size_t stride) {
+	const __m256i bswap = _mm256_setr_epi8(
+		3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+		3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12
+	);
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+		__m256i a, b;
+		bytes_to_hex(_mm256_shuffle_epi8(v, bswap), a, b);
+		/* a holds values {0, 1 | 4, 5} and b holds {2, 3 | 6, 7} */
+		__m128i a0 = _mm256_castsi256_si128(a);
+		__m128i a1 = _mm256_extracti128_si256(a, 1);
+		__m128i b0 = _mm256_castsi256_si128(b);
+		__m128i b1 = _mm256_extracti128_si256(b, 1);
+		char* out = dst + i * stride;
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(out + 0 * stride), a0);
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(out + 1 * stride), _mm_unpackhi_epi64(a0, a0));
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(out + 2 * stride), b0);
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(out + 3 * stride), _mm_unpackhi_epi64(b0, b0));
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(out + 4 * stride), a1);
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(out + 5 * stride), _mm_unpackhi_epi64(a1, a1));
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(out + 6 * stride), b1);
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(out + 7 * stride), _mm_unpackhi_epi64(b1, b1));
+	}
+	return i;
+}
+
+inline size_t digits_u64_avx2(const uint64_t* src, size_t count, char* dst, size_t stride) {
+	const __m256i bswap = _mm256_setr_epi8(
+		7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+		7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8
+	);
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+		__m256i a, b;
+		bytes_to_hex(_mm256_shuffle_epi8(v, bswap), a, b);
+		/* a holds values {0 | 2} and b holds {1 | 3} */
+		char* out = dst + i * stride;
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 0 * stride), _mm256_castsi256_si128(a));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 1 * stride), _mm256_castsi256_si128(b));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * stride), _mm256_extracti128_si256(a, 1));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 3 * stride), _mm256_extracti128_si256(b, 1));
+	}
+	return i;
+}
+
+#endif /* __AVX2__ */
+
+} /* namespace hex_encode_detail */
+
+/*
+** Encodes values[i] as `macro(0xXXXXXXXX)` at dst + i * stride.
+** @returns the number of bytes from dst to the end of the last literal.
+*/
+inline size_t encode_hex_literals(
+	std::span<const uint32_t> values, const char* macro, char* dst, size_t stride
+) {
+	if (values.empty()) {
+		return 0;
+	}
+	size_t head_len = hex_encode_detail::write_frames(values.size(), macro, 8, dst, stride);
+	char* digits = dst + head_len;
+	size_t i = 0;
+	#ifdef __AVX2__
+		i = hex_encode_detail::digits_u32_avx2(values.data(), values.size(), digits, stride);
+	#endif
+	for (; i < values.size(); i++) {
+		hex_digits_u32(digits + i * stride, values[i]);
+	}
+	return (values.size() - 1) * stride + head_len + 8 + 1;
+}
+
+/*
+** Encodes values[i] as `macro(0xXXXXXXXXXXXXXXXX)` at dst + i * stride.
+** @returns the number of bytes from dst to the end of the last literal.
+*/
+inline size_t encode_hex_literals(
+	std::span<const uint64_t> values, const char* macro, char* dst, size_t stride
+) {
+	if (values.empty()) {
+		return 0;
+	}
+	size_t head_len = hex_encode_detail::write_frames(values.size(), macro, 16, dst, stride);
+	char* digits = dst + head_len;
+	size_t i = 0;
+	#ifdef __AVX2__
+		i = hex_encode_detail::digits_u64_avx2(values.data(), values.size(), digits, stride);
+	#endif
+	for (; i < values.size(); i++) {
+		hex_digits_u64(digits + i * stride, values[i]);
+	}
+	return (values.size() - 1) * stride + head_len + 16 + 1;
+}
+
+inline size_t encode_hex_literals(
+	std::span<const int32_t> values, const char* macro, char* dst, size_t stride
+) {
+	return encode_hex_literals(
+		std::span<const uint32_t>(reinterpret_cast<const uint32_t*>(values.data()), values.size()),
+		macro, dst, stride
+	);
+}
+
+#endif /* HEX_ENCODE_H */
@@ -0,0 +1,99 @@
+#ifndef JOB_POOL_HPP
+#define JOB_POOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+** A fixed size thread pool. Jobs may submit further jobs. Follow-up jobs
+** can be queued at the front so that work already in flight (such as
+** exporting a generated table) finishes before new work is started.
+*/
+class Job_Pool {
+public:
+	explicit Job_Pool(size_t thread_count) {
+		if (thread_count == 0) {
+			thread_count = 1;
+		}
+		workers.reserve(thread_count);
+		for (size_t i = 0; i < thread_count; i++) {
+			workers.emplace_back([this] { worker_loop(); });
+		}
+	}
+
+	~Job_Pool() {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+		}
+		job_ready.notify_all();
+		for (std::thread& worker : workers) {
+			worker.join();
+		}
+	}
+
+	Job_Pool(const Job_Pool&) = delete;
+	Job_Pool& operator=(const Job_Pool&) = delete;
+
+	void submit(std::function<void()> job, bool front = false) {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if (front) {
+				jobs.push_front(std::move(job));
+			} else {
+				jobs.push_back(std::move(job));
+			}
+			pending++;
+		}
+		job_ready.notify_one();
+	}
+
+	/* blocks until every submitted job, including jobs they submit, has finished */
+	void wait() {
+		std::unique_lock<std::mutex> lock(mutex);
+		all_done.wait(lock, [this] { return pending == 0; });
+	}
+
+	size_t thread_count() const {
+		return workers.size();
+	}
+
+private:
+	void worker_loop() {
+		for (;;) {
+			std::function<void()> job;
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				job_ready.wait(lock, [this] { return stopping || !jobs.empty(); });
+				if (jobs.empty()) {
+					return;
+				}
+				job = std::move(jobs.front());
+				jobs.pop_front();
+			}
+			job();
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				pending--;
+				if (pending == 0) {
+					all_done.notify_all();
+				}
+			}
+		}
+	}
+
+	std::vector<std::thread> workers;
+	std::deque<std::function<void()>> jobs;
+	std::mutex mutex;
+	std::condition_variable job_ready;
+	std::condition_variable all_done;
+	size_t pending = 0;
+	bool stopping = false;
+};
+
+#endif /* JOB_POOL_HPP */
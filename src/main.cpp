@@ -7,7 +7,10 @@
 */
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cassert>
+#include <cinttypes>
 #include <climits>
 #include <cmath>
 #include <cstddef>
@@ -16,790 +19,697 @@
 #include <cstdlib>
 #include <cstring>
 #include <ctime>
+#include <filesystem>
 #include <limits>
+#include <map>
+#include <memory>
+#include <span>
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
-#include "edge_cases.h"
+#include "exhaustive_sweep.h"
+#include "half_tables.h"
+#include "job_pool.hpp"
+#include "options.h"
+#include "table_cache.hpp"
+#include "table_minimize.h"
+#include "table_stats.h"
 #include "test_gen.hpp"
+#include "test_list.h"
 
-#include "random_gen.h"
-
-#include "export_value.h"
+/* tables larger than this are generated in parallel slices */
+constexpr size_t parallel_slice_rows = 16384;
 
+/* tables of a fused group share the input columns, until a table is minimized */
 template<typename T>
-struct float_name {
-	static const char* fX;
-	static const char* fpX;
-	static const char* abi_type;
-	static const char* int_type;
-	static const char* int_literal;
-	static size_t type_bits;
+struct Table_Job {
+	const Test_Gen<T>& table;
+	std::shared_ptr<Record_Columns> input;
+	Record_Columns output;
+	std::atomic<size_t> slices_left;
+	/* set if --check-vector found a mismatch, so the table is not exported */
+	std::atomic<bool> mismatch = false;
+	/* null unless --stats */
+	Table_Stats* stats;
+	const Gen_Options& options;
+	uint64_t key;
+	std::vector<std::string> files;
+
+	Table_Job(
+		const Test_Gen<T>& test, std::shared_ptr<Record_Columns> input_columns, size_t rows,
+		size_t slice_count, Table_Stats* table_stats, const Gen_Options& job_options,
+		uint64_t cache_key, std::vector<std::string> file_names
+	) :
+		table(test),
+		input(std::move(input_columns)),
+		output(test.output_layout, rows),
+		slices_left(slice_count),
+		stats(table_stats),
+		options(job_options),
+		key(cache_key),
+		files(std::move(file_names))
+	{}
 };
 
-template<> const char* float_name<float>::fX = "f32";
-template<> const char* float_name<float>::fpX = "fp32";
-template<> const char* float_name<float>::abi_type = "float";
-template<> const char* float_name<float>::int_type = "uint32_t";
-template<> const char* float_name<float>::int_literal = "UINT32_C";
-template<> size_t float_name<float>::type_bits = 32;
+/* replaces the candidate rows of a job with the subset covering the same features */
+template<typename T>
+void minimize_job(Table_Job<T>& job) {
+	const size_t candidates = job.input->size();
+	const Minimized_Rows minimized = minimize_rows(*job.input, job.output);
+	job.input = std::make_shared<Record_Columns>(select_rows(*job.input, minimized.rows));
+	job.output = select_rows(job.output, minimized.rows);
+	printf(
+		"Minimized \"%s\" from %zu to %zu rows, covering %zu features\n",
+		table_prefix(job.table).c_str(), candidates, minimized.rows.size(),
+		minimized.feature_count
+	);
+}
 
-template<> const char* float_name<double>::fX = "f64";
-template<> const char* float_name<double>::fpX = "fp64";
-template<> const char* float_name<double>::abi_type = "long double";
-template<> const char* float_name<double>::int_type = "uint64_t";
-template<> const char* float_name<double>::int_literal = "UINT64_C";
-template<> size_t float_name<double>::type_bits = 64;
+/* exports a job once all of its slices are generated */
+template<typename T>
+void export_job(Table_Job<T>& job, Table_Cache* cache) {
+	Stage_Timer timer(job.stats, stats_export);
+	if (job.options.minimize != 0) {
+		minimize_job(job);
+	}
+	const unsigned formats = job.options.formats;
+	if (writes_header_table(job.table, formats)) {
+		export_table(job.table, *job.input, job.output, cache, job.key);
+	}
+	if (writes_shared_table(job.table, formats)) {
+		export_table_shared(job.table, job.output, cache, job.key);
+	}
+	if (formats & format_binary) {
+		export_table_binary(job.table, *job.input, job.output, job.options.seed, cache, job.key);
+	}
+	if (formats & format_encoded) {
+		export_table_encoded(job.table, *job.input, job.output, cache, job.key);
+	}
+	finish_table_stats(job.stats, job.files);
+}
 
-template <typename T>
-inline void generate_ilogb_test(
-	std::vector<std::string>& input,
-	std::vector<std::string>& output
+/*
+** Generates a slice of the shared input of jobs, and evaluates each job
+** over it. A group of several jobs is evaluated fuse_block_rows at a time,
+** so each block of inputs is read from the cache by every table in turn.
+** Jobs whose last slice this is are exported ahead of the remaining jobs.
+*/
+template<typename T>
+void generate_slice(
+	Job_Pool& pool, const std::vector<std::shared_ptr<Table_Job<T>>>& jobs,
+	const Gen_Slice& slice, Table_Cache* cache, std::atomic<bool>& check_failed
 ) {
-	assert(input.size() == output.size());
-	std::vector<T> values(input.size());
-	std::copy(edge_cases<T>.begin(), edge_cases<T>.end(), values.begin());
-	random_gen_basic(values, edge_cases<T>.size());
-	for (size_t i = 0; i < input.size(); i++) {
-		input[i] = export_value(values[i]);
-		int fp_class = std::fpclassify(values[i]);
-		int result = std::ilogb(values[i]);
-		switch(fp_class) {
-			case FP_INFINITE: output[i] = "INT_MAX"; break;
-			case FP_NAN: output[i] = "FP_ILOGBNAN"; break;
-			case FP_ZERO: output[i] = "FP_ILOGB0"; break;
-			default: output[i] = std::to_string(result);
+	Record_Columns& input = *jobs.front()->input;
+	/* the input of a group is timed in the stats of its first table */
+	{
+		Stage_Timer timer(jobs.front()->stats, stats_input);
+		jobs.front()->table.generate_input(slice, input);
+	}
+	const size_t block_rows = (jobs.size() > 1) ? fuse_block_rows : slice.end - slice.begin;
+	for (size_t begin = slice.begin; begin < slice.end; begin += block_rows) {
+		const size_t end = std::min(slice.end, begin + block_rows);
+		for (const std::shared_ptr<Table_Job<T>>& job : jobs) {
+			Stage_Timer timer(job->stats, stats_evaluate);
+			job->table.evaluate(input, job->output, begin, end);
 		}
 	}
+	for (const std::shared_ptr<Table_Job<T>>& job : jobs) {
+		if (job->options.check_vector) {
+			Stage_Timer timer(job->stats, stats_check);
+			if (!job->table.matches_reference(input, job->output, slice.begin, slice.end)) {
+				job->mismatch = true;
+				check_failed = true;
+			}
+		}
+		if (job->slices_left.fetch_sub(1) != 1 || job->mismatch) {
+			continue;
+		}
+		pool.submit([job, cache] {
+			export_job(*job, cache);
+		}, true);
+	}
 }
 
-template <typename T>
-inline void generate_logb_test(
-	std::vector<std::string>& input,
-	std::vector<std::string>& output
+/* a table to generate, with the options of the job that selected it */
+template<typename T>
+struct Table_Request {
+	const Test_Gen<T>& table;
+	const Gen_Options& options;
+};
+
+/* the cache key and formats of each table selected so far, by prefix */
+using Selected_Tables = std::map<std::string, std::pair<uint64_t, unsigned>>;
+
+/*
+** Adds the tables selected by each job to requests, skipping tables that an
+** earlier job already generates identically, such as a table listed twice.
+** @returns false if two jobs generate the same table differently
+*/
+template<typename T>
+bool select_tables(
+	const std::vector<Test_Gen<T>>& Test_List, const std::vector<Gen_Options>& jobs,
+	Selected_Tables& selected, std::vector<Table_Request<T>>& requests
 ) {
-	assert(input.size() == output.size());
-	std::vector<T> values(input.size());
-	std::copy(edge_cases<T>.begin(), edge_cases<T>.end(), values.begin());
-	random_gen_basic(values, edge_cases<T>.size());
-	for (size_t i = 0; i < input.size(); i++) {
-		input[i] = export_value(values[i]);
-		T result = std::logb(values[i]);
-		output[i] = export_value(result);
+	for (const Gen_Options& options : jobs) {
+		for (const Test_Gen<T>& table : Test_List) {
+			if (!table_selected(table, options)) {
+				continue;
+			}
+			const std::pair<uint64_t, unsigned> job = {table_key(table, options), options.formats};
+			auto [iter, inserted] = selected.try_emplace(table_prefix(table), job);
+			if (inserted) {
+				requests.push_back({table, options});
+			} else if (iter->second != job) {
+				printf(
+					"Error: \"%s\" is generated by jobs with different options\n",
+					table_prefix(table).c_str()
+				);
+				return false;
+			}
+		}
 	}
+	return true;
 }
 
-template <typename T>
-inline void generate_frexp_test(
-	std::vector<std::string>& input,
-	std::vector<std::string>& output
+/* @returns false if a job names a table that does not exist */
+inline bool check_table_names(
+	const std::vector<Gen_Options>& jobs,
+	const std::vector<Test_Gen<float>>& f32_tests, const std::vector<Test_Gen<double>>& f64_tests,
+	const std::vector<std::string>& dense_functions
 ) {
-	assert(input.size() == output.size());
-	std::vector<T> values(input.size());
-	std::copy(edge_cases<T>.begin(), edge_cases<T>.end(), values.begin());
-	random_gen_basic(values, edge_cases<T>.size());
-	for (size_t i = 0; i < input.size(); i++) {
-		input[i] = export_value(values[i]);
-		int fp_class = std::fpclassify(values[i]);
-		int expon;
-		T result = std::frexp(values[i], &expon);
-		output[i] = "{";
-		output[i] += export_value(result);
-		output[i] += ", ";
-		switch(fp_class) {
-			case FP_INFINITE: output[i] += "INT_MAX"; break;
-			case FP_NAN: output[i] += "FP_ILOGBNAN"; break;
-			case FP_ZERO: output[i] += "FP_ILOGB0"; break;
-			default: output[i] += std::to_string(expon);
+	for (const Gen_Options& options : jobs) {
+		for (const std::string& name : options.tables) {
+			auto matches = [&](const auto& table) { return table_matches(table, name); };
+			if (
+				std::none_of(f32_tests.begin(), f32_tests.end(), matches) &&
+				std::none_of(f64_tests.begin(), f64_tests.end(), matches) &&
+				!is_half_table_name(dense_functions, name)
+			) {
+				printf("Error: unknown table \"%s\"\n", name.c_str());
+				return false;
+			}
 		}
-		output[i] += "}";
 	}
+	return true;
 }
 
-template <typename T>
-inline void generate_ldexp_test(
-	std::vector<std::string>& input,
-	std::vector<std::string>& output
+/*
+** Writes the shared inputs of the tables of requests in --format shared.
+** @returns false if they are requested with different seeds
+*/
+template<typename T>
+bool export_shared_inputs(
+	const std::vector<Test_Gen<T>>& tests, const std::vector<Table_Request<T>>& requests,
+	Table_Cache* cache
 ) {
-	assert(input.size() == output.size());
-	std::vector<T> values(input.size());
-	std::vector<int> expon(input.size());
-
-	std::random_device rd;
-	std::mt19937 gen(rd());
-	
-	int rand_expon_range
-	= std::numeric_limits<T>::max_exponent
-	- std::numeric_limits<T>::min_exponent
-	+ std::numeric_limits<T>::digits;
-	
-	const std::vector<int> expon_edge_cases = {
-		0, 1, -1, 2, -2,
-		std::numeric_limits<T>::digits,
-		std::numeric_limits<T>::max_exponent,
-		rand_expon_range,
-		rand_expon_range - 1,
-		-std::numeric_limits<T>::digits,
-		-std::numeric_limits<T>::max_exponent,
-		-rand_expon_range,
-		-rand_expon_range + 1,
-	};
-	
-	if (input.size() < edge_cases<T>.size() * expon_edge_cases.size()) {
-		printf(
-			"Error: Input size (%zu) must be at least %zu\n",
-			input.size(), edge_cases<T>.size() * expon_edge_cases.size()
-		);
-		return;
-	}
-	
-	random_gen_basic(values, edge_cases<T>.size() * expon_edge_cases.size());
-	std::uniform_int_distribution<int> dist(
-		-rand_expon_range, rand_expon_range
-	);
-	{
-		size_t offset = 0;
-		for (size_t e = 0; e < expon_edge_cases.size(); e++) {
-			for (size_t i = 0; i < edge_cases<T>.size(); i++) {
-				values[offset] = edge_cases<T>[i];
-				expon[offset] = expon_edge_cases[e];
-				offset++;
-			}
+	const Gen_Options* shared = nullptr;
+	for (const Table_Request<T>& request : requests) {
+		if (!writes_shared_table(request.table, request.options.formats)) {
+			continue;
 		}
-		for (; offset < expon.size(); offset++) {
-			expon[offset] = dist(gen);
-			if (offset % 16 != 0) {
-				expon[offset] /= std::numeric_limits<T>::max_exponent / 64;
-			}
+		if (shared != nullptr && shared->seed != request.options.seed) {
+			printf(
+				"Error: \"%s.h\" is shared by jobs with different seeds\n",
+				shared_input_name<T>().c_str()
+			);
+			return false;
 		}
+		shared = &request.options;
 	}
-
-	for (size_t i = 0; i < input.size(); i++) {
-		input[i] = "{";
-		input[i] += export_value(values[i]);
-		input[i] += ", ";
-		input[i] += std::to_string(expon[i]);
-		input[i] += "}";
-
-		T result = std::ldexp(values[i], expon[i]);
-		output[i] = export_value(result);
+	if (shared != nullptr) {
+		export_shared_inputs<T>(shared_input_rows(tests, *shared), shared->seed, cache);
 	}
+	return true;
 }
 
-template <typename T>
-inline void generate_nextafter_test(
-	std::vector<std::string>& input,
-	std::vector<std::string>& output
+/*
+** Each table is split into slices that are generated as separate jobs.
+** Once the last slice of a table is generated, its export is queued ahead
+** of the remaining generation jobs, so that generating one table overlaps
+** with exporting another without holding every table in memory.
+** With fuse, the unary tables of the same size and seed are grouped, and
+** each slice of their input is generated once for the whole group. Their
+** inputs only depend on the seed and the row, so the tables are identical
+** to the tables generated separately.
+** Tables that are generated are added to stats_list, if it is not null.
+*/
+template<typename T>
+void schedule_all_tests(
+	Job_Pool& pool, const std::vector<Table_Request<T>>& requests, bool fuse,
+	Table_Cache* cache, std::atomic<bool>& check_failed, Stats_List* stats_list
 ) {
-	assert(input.size() == output.size());
-	std::vector<T> values(input.size());
-	std::vector<T> target(input.size());
-	
-	const std::vector<T> target_edge_cases = {
-		static_cast<T>(0.0),
-		std::numeric_limits<T>::denorm_min(),
-		static_cast<T>(1.0),
-		std::numeric_limits<T>::max(),
-		std::numeric_limits<T>::infinity(),
-		std::numeric_limits<T>::quiet_NaN(),
-		std::numeric_limits<T>::signaling_NaN(),
-		-static_cast<T>(0.0),
-		-std::numeric_limits<T>::denorm_min(),
-		-static_cast<T>(1.0),
-		-std::numeric_limits<T>::max(),
-		-std::numeric_limits<T>::infinity(),
-		-std::numeric_limits<T>::quiet_NaN(),
-		-std::numeric_limits<T>::signaling_NaN(),
-	};
-	
-	if (input.size() < edge_cases<T>.size() * target_edge_cases.size()) {
-		printf(
-			"Error: Input size (%zu) must be at least %zu\n",
-			input.size(), edge_cases<T>.size() * target_edge_cases.size()
+	using Job_Group = std::vector<std::shared_ptr<Table_Job<T>>>;
+	std::vector<Job_Group> groups;
+	/* the group of the unary tables of each size and seed */
+	std::map<std::pair<size_t, uint64_t>, size_t> fused_groups;
+	for (const Table_Request<T>& request : requests) {
+		const Test_Gen<T>& table = request.table;
+		const Gen_Options& options = request.options;
+		if (options.formats & format_driver) {
+			export_table_driver(table, cache);
+		}
+		const uint64_t key = table_key(table, options);
+		const std::vector<std::string> files = table_output_files(table, options.formats);
+		if (cache != nullptr && std::all_of(files.begin(), files.end(), [&](const std::string& file) {
+			return cache->is_fresh(file, key);
+		})) {
+			for (const std::string& file : files) {
+				printf("Up to date \"%s\"\n", file.c_str());
+			}
+			continue;
+		}
+		size_t elem_count = table_rows(table, options);
+		Table_Stats* stats = nullptr;
+		if (stats_list != nullptr) {
+			stats = &stats_list->emplace_back(float_name<T>::fX, table.table_name, elem_count);
+		}
+		if (options.count != 0) {
+			const uint64_t seed = options.seed;
+			std::atomic<bool>* check = options.check_vector ? &check_failed : nullptr;
+			pool.submit([&table, elem_count, seed, cache, key, check, stats, files] {
+				const std::string file_name = table_file_name(table);
+				const std::string timestamp = get_ISO8601Timestamp();
+				Write_Status status = stream_table(
+					table, file_name, elem_count, seed,
+					table_text(table, elem_count, timestamp), timestamp, cache, key, check, stats
+				);
+				print_write_status(status, file_name);
+				finish_table_stats(stats, files);
+			});
+			continue;
+		}
+		size_t slice_count = std::max<size_t>(
+			(elem_count + parallel_slice_rows - 1) / parallel_slice_rows, 1
 		);
-		return;
+		size_t group = groups.size();
+		if (fuse && has_shared_input(table)) {
+			group = fused_groups.try_emplace({elem_count, options.seed}, groups.size()).first->second;
+		}
+		if (group == groups.size()) {
+			groups.emplace_back();
+		}
+		std::shared_ptr<Record_Columns> input = groups[group].empty() ?
+			std::make_shared<Record_Columns>(table.input_layout, elem_count) :
+			groups[group].front()->input;
+		groups[group].push_back(std::make_shared<Table_Job<T>>(
+			table, input, elem_count, slice_count, stats, options, key, files
+		));
 	}
-	
-	random_gen_basic(values, edge_cases<T>.size() * target_edge_cases.size());
-	random_gen_basic(target, edge_cases<T>.size() * target_edge_cases.size());
-
-	{
-		size_t offset = 0;
-		for (size_t t = 0; t < target_edge_cases.size(); t++) {
-			for (size_t i = 0; i < edge_cases<T>.size(); i++) {
-				values[offset] = edge_cases<T>[i];
-				target[offset] = target_edge_cases[t];
-				offset++;
-			}
+	for (const Job_Group& jobs : groups) {
+		const size_t elem_count = jobs.front()->output.size();
+		for (size_t begin = 0; begin == 0 || begin < elem_count; begin += parallel_slice_rows) {
+			Gen_Slice slice;
+			slice.seed = jobs.front()->options.seed;
+			slice.table_rows = elem_count;
+			slice.index_base = 0;
+			slice.begin = begin;
+			slice.end = std::min(elem_count, begin + parallel_slice_rows);
+			pool.submit([&pool, &check_failed, jobs, slice, cache] {
+				generate_slice(pool, jobs, slice, cache, check_failed);
+			});
 		}
 	}
+}
 
-	for (size_t i = 0; i < input.size(); i++) {
-		input[i] = "{";
-		input[i] += export_value(values[i]);
-		input[i] += ", ";
-		input[i] += export_value(target[i]);
-		input[i] += "}";
+struct Sweep_Job {
+	const Test_Gen<float>& table;
+	Record_Columns checksums;
+	std::atomic<size_t> jobs_left;
+	std::atomic<bool> mismatch = false;
+	uint64_t key;
+	bool check;
+
+	Sweep_Job(const Test_Gen<float>& test, size_t job_count, uint64_t cache_key, bool check_vector) :
+		table(test),
+		checksums({{Field_Kind::u64}}, sweep_block_count),
+		jobs_left(job_count),
+		key(cache_key),
+		check(check_vector)
+	{}
+};
 
-		T result = ieee_nextafter(values[i], target[i]);
-		output[i] = export_value(result);
+/* queues the export of a sweep once its last job is done */
+void finish_sweep(Job_Pool& pool, const std::shared_ptr<Sweep_Job>& job, Table_Cache* cache) {
+	if (job->jobs_left.fetch_sub(1) != 1 || job->mismatch) {
+		return;
 	}
+	pool.submit([job, cache] {
+		const Sweep_Table sweep = {
+			table_prefix(job->table), job->table.headers, get_ISO8601Timestamp(),
+			job->table.output_layout, job->checksums
+		};
+		export_sweep_table(sweep, cache, job->key);
+	}, true);
 }
 
-template <typename T>
-inline void generate_fma_test(
-	std::vector<std::string>& input,
-	std::vector<std::string>& output
+/*
+** Sweeps every selected unary f32 table, exporting each once its last block
+** is done. With fuse, each job sweeps its blocks for every table at once.
+*/
+void schedule_sweeps(
+	Job_Pool& pool, const std::vector<Table_Request<float>>& requests, bool fuse,
+	Table_Cache* cache, std::atomic<bool>& check_failed
 ) {
-	assert(input.size() == output.size());
-
-	const std::vector<T> fma_edge_cases = {
-		static_cast<T>(0.0),
-		static_cast<T>(1.0),
-		std::numeric_limits<T>::infinity(),
-		std::numeric_limits<T>::quiet_NaN(),
-		-static_cast<T>(0.0),
-		-static_cast<T>(1.0),
-		-std::numeric_limits<T>::infinity(),
-		-std::numeric_limits<T>::quiet_NaN(),
-	};
-	
-	size_t offset = fma_edge_cases.size() * fma_edge_cases.size() * fma_edge_cases.size();
-
-	if (input.size() < offset) {
-		printf(
-			"Error: Input size (%zu) must be at least %zu\n",
-			input.size(), offset
-		);
+	const size_t job_count = sweep_block_count / sweep_job_blocks;
+	std::vector<std::shared_ptr<Sweep_Job>> sweeps;
+	for (const Table_Request<float>& request : requests) {
+		const Test_Gen<float>& table = request.table;
+		const Gen_Options& options = request.options;
+		if (!is_unary_table(table)) {
+			continue;
+		}
+		const uint64_t key = hash_value(sweep_block_bits, table_key(table, options));
+		const std::string file_name = table_prefix(table) + "_sweep.h";
+		if (cache != nullptr && cache->is_fresh(file_name, key)) {
+			printf("Up to date \"%s\"\n", file_name.c_str());
+			continue;
+		}
+		sweeps.push_back(std::make_shared<Sweep_Job>(table, job_count, key, options.check_vector));
+	}
+	if (fuse && !sweeps.empty()) {
+		for (size_t j = 0; j < job_count; j++) {
+			pool.submit([&pool, &check_failed, sweeps, j, cache] {
+				std::vector<Fused_Sweep> fused;
+				for (const std::shared_ptr<Sweep_Job>& job : sweeps) {
+					fused.push_back({
+						job->table, job->checksums[0].values<uint64_t>().data(), job->check
+					});
+				}
+				sweep_blocks_fused(fused, j * sweep_job_blocks, (j + 1) * sweep_job_blocks);
+				for (size_t t = 0; t < sweeps.size(); t++) {
+					if (fused[t].mismatch) {
+						sweeps[t]->mismatch = true;
+						check_failed = true;
+					}
+					finish_sweep(pool, sweeps[t], cache);
+				}
+			});
+		}
 		return;
 	}
-
-	std::vector<T> x(input.size());
-	std::vector<T> y(input.size());
-	std::vector<T> z(input.size());
-
-	{
-		size_t i = 0;
-		for (size_t i0 = 0; i0 < fma_edge_cases.size(); i0++) {
-			for (size_t i1 = 0; i1 < fma_edge_cases.size(); i1++) {
-				for (size_t i2 = 0; i2 < fma_edge_cases.size(); i2++) {
-					x[i] = fma_edge_cases[i0];
-					y[i] = fma_edge_cases[i1];
-					z[i] = fma_edge_cases[i2];
-					i++;
+	for (const std::shared_ptr<Sweep_Job>& job : sweeps) {
+		for (size_t j = 0; j < job_count; j++) {
+			pool.submit([&pool, &check_failed, job, j, cache] {
+				Sweep_Buffers buffers(job->table.input_layout, job->table.output_layout);
+				if (!sweep_blocks(
+					job->table, j * sweep_job_blocks, (j + 1) * sweep_job_blocks,
+					buffers, job->checksums[0].values<uint64_t>().data(), job->check
+				)) {
+					job->mismatch = true;
+					check_failed = true;
 				}
-			}
+				finish_sweep(pool, job, cache);
+			});
 		}
 	}
-
-	random_gen_basic(x, offset);
-	random_gen_basic(y, offset);
-	random_gen_basic(z, offset);
-
-	for (size_t i = 0; i < input.size(); i++) {
-		input[i] = "{";
-		input[i] += export_value(x[i]);
-		input[i] += ", ";
-		input[i] += export_value(y[i]);
-		input[i] += ", ";
-		input[i] += export_value(z[i]);
-		input[i] += "}";
-
-		T result = std::fma(x[i], y[i], z[i]);
-		output[i] = export_value(result);
-	}
 }
 
-template <typename T>
-inline void generate_sqrt_test(
-	std::vector<std::string>& input,
-	std::vector<std::string>& output
+/*
+** Adds the tables of Format selected by jobs to selected, one for each of
+** functions. @returns the functions of those tables
+*/
+template<typename Format, typename Functions>
+auto select_half_tables(
+	const Functions& functions, const char* kind, const std::vector<Gen_Options>& jobs,
+	Selected_Tables& selected
 ) {
-	assert(input.size() == output.size());
-	std::vector<T> values(input.size());
-	std::copy(edge_cases<T>.begin(), edge_cases<T>.end(), values.begin());
-	random_gen_basic(values, edge_cases<T>.size());
-	for (size_t i = 0; i < input.size(); i++) {
-		input[i] = export_value(values[i]);
-		T result = std::sqrt(values[i]);
-		output[i] = export_value(result);
+	std::vector<const typename Functions::value_type*> requests;
+	for (const Gen_Options& options : jobs) {
+		for (const auto& function : functions) {
+			const char* name = dense_function_name(function);
+			if (!half_table_selected<Format>(name, kind, options)) {
+				continue;
+			}
+			/* a table depends on nothing but its name, so a table listed twice is the same */
+			const std::pair<uint64_t, unsigned> job = {
+				dense_function_key<Format>(function, kind), format_header
+			};
+			if (selected.try_emplace(half_table_prefix<Format>(name, kind), job).second) {
+				requests.push_back(&function);
+			}
+		}
 	}
+	return requests;
 }
 
-template <typename T>
-inline void generate_float_to_f32_test(
-	std::vector<std::string>& input,
-	std::vector<std::string>& output
-) {
-	assert(input.size() == output.size());
-	std::vector<T> values(input.size());
-	std::copy(edge_cases<T>.begin(), edge_cases<T>.end(), values.begin());
-	random_gen_basic(values, edge_cases<T>.size());
-	for (size_t i = 0; i < input.size(); i++) {
-		input[i] = export_value(values[i]);
-		float result = static_cast<float>(values[i]);
-		output[i] = export_value(result);
-	}
-}
+/* the tables of Format selected by jobs */
+struct Half_Requests {
+	std::vector<const Oracle_Function<1>*> dense;
+	std::vector<const Exact_Dense_Function<float>*> f32_exact;
+	std::vector<const Exact_Dense_Function<double>*> f64_exact;
+	/* empty unless --exhaustive */
+	std::vector<const Oracle_Function<2>*> sweeps;
+};
 
-template <typename T>
-inline void generate_float_to_f64_test(
-	std::vector<std::string>& input,
-	std::vector<std::string>& output
+template<typename Format>
+Half_Requests select_half_requests(
+	const std::vector<Oracle_Function<1>>& functions,
+	const std::vector<Exact_Dense_Function<float>>& f32_exact,
+	const std::vector<Exact_Dense_Function<double>>& f64_exact,
+	const std::vector<Gen_Options>& jobs, bool exhaustive, Selected_Tables& selected
 ) {
-	assert(input.size() == output.size());
-	std::vector<T> values(input.size());
-	std::copy(edge_cases<T>.begin(), edge_cases<T>.end(), values.begin());
-	random_gen_basic(values, edge_cases<T>.size());
-	for (size_t i = 0; i < input.size(); i++) {
-		input[i] = export_value(values[i]);
-		double result = static_cast<double>(values[i]);
-		output[i] = export_value(result);
-	}
+	Half_Requests requests;
+	requests.dense = select_half_tables<Format>(functions, dense_kind, jobs, selected);
+	requests.f32_exact = select_half_tables<Format>(f32_exact, dense_kind, jobs, selected);
+	requests.f64_exact = select_half_tables<Format>(f64_exact, dense_kind, jobs, selected);
+	if (exhaustive) {
+		requests.sweeps =
+			select_half_tables<Format>(oracle_binary_functions, sweep_kind, jobs, selected);
+	}
+	return requests;
 }
 
-template <typename T>
-inline void generate_modf_test(
-	std::vector<std::string>& input,
-	std::vector<std::string>& output
-) {
-	assert(input.size() == output.size());
-	std::vector<T> values(input.size());
-	std::copy(edge_cases<T>.begin(), edge_cases<T>.end(), values.begin());
-	random_gen_basic(values, edge_cases<T>.size());
-	for (size_t i = 0; i < input.size(); i++) {
-		input[i] = export_value(values[i]);
-		T integral_part;
-		T result = std::modf(values[i], &integral_part);
-		output[i] = "{";
-		output[i] += export_value(result);
-		output[i] += ", ";
-		output[i] += export_value(integral_part);
-		output[i] += "}";
+/* warns of the rows of a 16bit table left unresolved by the oracle */
+template<typename Format>
+void print_half_unresolved(const char* function, const char* kind, uint64_t unresolved) {
+	if (unresolved != 0) {
+		printf(
+			"Warning: %" PRIu64 " rows of %s may not be correctly rounded\n",
+			unresolved, half_table_prefix<Format>(function, kind).c_str()
+		);
 	}
 }
 
-template <typename T>
-inline void generate_rounding_test(
-	std::vector<std::string>& input,
-	std::vector<std::string>& output
+/* evaluates and exports each dense table in a job of its own */
+template<typename Format>
+void schedule_dense_tables(
+	Job_Pool& pool, const std::vector<const Oracle_Function<1>*>& functions, Table_Cache* cache
 ) {
-	assert(input.size() == output.size());
-	std::vector<T> values(input.size());
-	std::copy(edge_cases<T>.begin(), edge_cases<T>.end(), values.begin());
-	random_gen_basic(values, edge_cases<T>.size());
-	for (size_t i = 0; i < input.size(); i++) {
-		input[i] = export_value(values[i]);
-		output[i] = "{";
-		output[i] += export_value(std::floor(values[i]));
-		output[i] += ", ";
-		output[i] += export_value(std::ceil(values[i]));
-		output[i] += ", ";
-		output[i] += export_value(std::round(values[i]));
-		output[i] += "}";
+	for (const Oracle_Function<1>* function : functions) {
+		const uint64_t key = half_table_key<Format>(function->name, dense_kind);
+		const std::string file_name = half_table_prefix<Format>(function->name, dense_kind) + ".h";
+		if (cache != nullptr && cache->is_fresh(file_name, key)) {
+			printf("Up to date \"%s\"\n", file_name.c_str());
+			continue;
+		}
+		pool.submit([function, key, cache] {
+			const uint64_t unresolved = oracle_unresolved;
+			const std::vector<uint16_t> results = dense_unary_results<Format>(*function);
+			const uint64_t function_unresolved = oracle_unresolved - unresolved;
+			print_half_unresolved<Format>(function->name, dense_kind, function_unresolved);
+			export_dense_table<Format>(function->name, results, get_ISO8601Timestamp(), cache, key);
+		});
 	}
 }
 
-template <typename T>
-inline void generate_float_to_integer_test(
-	std::vector<std::string>& input,
-	std::vector<std::string>& output
+/* evaluates and exports each exact dense table in a job of its own */
+template<typename Format, typename T>
+void schedule_exact_dense_tables(
+	Job_Pool& pool, const std::vector<const Exact_Dense_Function<T>*>& functions,
+	Table_Cache* cache
 ) {
-	assert(input.size() == output.size());
-	std::vector<T> values(input.size());
-	#if 0
-		std::vector<T> integer_edge_cases = {
-			static_cast<T>(UINT32_MAX),
-			static_cast<T>(INT32_MAX),
-			static_cast<T>(INT32_MIN),
-			static_cast<T>(UINT64_MAX),
-			static_cast<T>(INT64_MAX),
-			static_cast<T>(INT64_MIN),
-		};
-		std::copy(edge_cases<T>.begin(), edge_cases<T>.end(), values.begin());
-		std::copy(
-			integer_edge_cases.begin(), integer_edge_cases.end(),
-			values.begin() + edge_cases<T>.size()
-		);
-
-		std::random_device rd;
-		std::mt19937_64 gen(rd());
-		std::uniform_real_distribution<T> dist_low(static_cast<T>(-0x1.0p+1), static_cast<T>(+0x1.0p+1));
-		std::uniform_real_distribution<T> dist_u30(static_cast<T>(-0x1.0p+30), static_cast<T>(+0x1.0p+30));
-		std::uniform_real_distribution<T> dist_u60(static_cast<T>(-0x1.0p+60), static_cast<T>(+0x1.0p+60));
-		std::uniform_real_distribution<T> dist_all;
-		for (size_t i = edge_cases<T>.size() + integer_edge_cases.size(); i < input.size(); i++) {
-			switch (i % 4) {
-				case 0: values[i] = dist_low(gen); break;
-				case 1: values[i] = dist_u30(gen); break;
-				case 2: values[i] = dist_u60(gen); break;
-				case 3: values[i] = dist_all(gen); break;
-			}
-		}
-	#else
-		std::random_device rd;
-		std::mt19937_64 gen(rd());
-		std::uniform_real_distribution<T> dist_u30(static_cast<T>(-0x1.0p+30), static_cast<T>(+0x1.0p+30));
-
-		std::vector<T> integer_edge_cases = {
-			static_cast<T>(0.0),
-			static_cast<T>(0.5),
-			static_cast<T>(1.0),
-			static_cast<T>(1.5),
-			static_cast<T>(2.0),
-			static_cast<T>(2.5),
-			static_cast<T>(-0.0),
-			static_cast<T>(-0.5),
-			static_cast<T>(-1.0),
-			static_cast<T>(-1.5),
-			static_cast<T>(-2.0),
-			static_cast<T>(-2.5),
-		};
-		std::copy(integer_edge_cases.begin(), integer_edge_cases.end(), values.begin());
-
-		for (size_t i = integer_edge_cases.size(); i < input.size(); i++) {
-			values[i] = dist_u30(gen);
+	for (const Exact_Dense_Function<T>* function : functions) {
+		const uint64_t key = dense_function_key<Format>(*function, dense_kind);
+		const std::string file_name =
+			half_table_prefix<Format>(function->name.c_str(), dense_kind) + ".h";
+		if (cache != nullptr && cache->is_fresh(file_name, key)) {
+			printf("Up to date \"%s\"\n", file_name.c_str());
+			continue;
 		}
-	#endif
-	for (size_t i = 0; i < input.size(); i++) {
-		input[i] = export_value(values[i]);
-		output[i] = "{";
-		output[i] += export_value((uint32_t)(values[i]));
-		output[i] += ", ";
-		output[i] += export_value((int32_t)(values[i]));
-		output[i] += ", ";
-		output[i] += export_value((uint64_t)(values[i]));
-		output[i] += ", ";
-		output[i] += export_value((int64_t)(values[i]));
-		output[i] += "}";
+		pool.submit([function, key, cache] {
+			const Record_Columns outputs = exact_dense_results<Format>(*function);
+			export_exact_dense_table<Format>(
+				*function, outputs, get_ISO8601Timestamp(), cache, key
+			);
+		});
 	}
 }
 
-template <typename T>
-inline void generate_float_from_integer_test(
-	std::vector<std::string>& input,
-	std::vector<std::string>& output
-) {
-	assert(input.size() == output.size());
-	std::vector<uint32_t> input_u32(input.size());
-	std::vector<uint64_t> input_u64(input.size());
-
-	size_t offset = 0;
-	input_u32[offset] = 0;
-	input_u64[offset] = 0;
-	offset++;
-	input_u32[offset] = 1;
-	input_u64[offset] = 1;
-	offset++;
-	input_u32[offset] = std::numeric_limits<uint32_t>::max();
-	input_u64[offset] = std::numeric_limits<uint64_t>::max();
-	offset++;
-	input_u32[offset] = std::numeric_limits<int32_t>::max();
-	input_u64[offset] = std::numeric_limits<int64_t>::max();
-	offset++;
-	input_u32[offset] = static_cast<uint32_t>(std::numeric_limits<int32_t>::min());
-	input_u64[offset] = static_cast<uint64_t>(std::numeric_limits<int64_t>::min());
-	offset++;
-
-	std::random_device rd;
-	std::mt19937_64 gen(rd());
-	std::uniform_int_distribution<uint64_t> dist;
-	for (size_t i = offset; i < input.size(); i++) {
-		input_u32[i] = static_cast<uint32_t>(dist(gen));
-		input_u64[i] = static_cast<uint64_t>(dist(gen));
-	}
+struct Tile_Sweep_Job {
+	const Oracle_Function<2>& function;
+	Record_Columns checksums;
+	std::atomic<size_t> jobs_left;
+	std::atomic<uint64_t> unresolved = 0;
+	uint64_t key;
+
+	Tile_Sweep_Job(const Oracle_Function<2>& sweep_function, size_t job_count, uint64_t cache_key) :
+		function(sweep_function),
+		checksums({{Field_Kind::u64}}, tile_count),
+		jobs_left(job_count),
+		key(cache_key)
+	{}
+};
 
-	for (size_t i = 0; i < input.size(); i++) {
-		input[i] = "{";
-		input[i] += export_value(input_u32[i]);
-		input[i] += ", ";
-		input[i] += export_value(input_u64[i]);
-		input[i] += "}";
-		output[i] = "{";
-		output[i] += export_value(static_cast<T>(input_u32[i]));
-		output[i] += ", ";
-		output[i] += export_value(static_cast<T>(static_cast<int32_t>(input_u32[i])));
-		output[i] += ", ";
-		output[i] += export_value(static_cast<T>(input_u64[i]));
-		output[i] += ", ";
-		output[i] += export_value(static_cast<T>(static_cast<int64_t>(input_u64[i])));
-		output[i] += "}";
+/* sweeps each binary function over every pair of Format, exporting each after its last tile */
+template<typename Format>
+void schedule_tile_sweeps(
+	Job_Pool& pool, const std::vector<const Oracle_Function<2>*>& functions, Table_Cache* cache
+) {
+	const size_t job_count = tile_count / sweep_job_tiles;
+	for (const Oracle_Function<2>* function : functions) {
+		const uint64_t key = half_table_key<Format>(function->name, sweep_kind);
+		const std::string file_name = half_table_prefix<Format>(function->name, sweep_kind) + ".h";
+		if (cache != nullptr && cache->is_fresh(file_name, key)) {
+			printf("Up to date \"%s\"\n", file_name.c_str());
+			continue;
+		}
+		auto job = std::make_shared<Tile_Sweep_Job>(*function, job_count, key);
+		for (size_t j = 0; j < job_count; j++) {
+			pool.submit([&pool, job, j, cache] {
+				const uint64_t unresolved = oracle_unresolved;
+				sweep_tiles<Format>(
+					job->function, j * sweep_job_tiles, (j + 1) * sweep_job_tiles,
+					job->checksums[0].values<uint64_t>().data()
+				);
+				job->unresolved += oracle_unresolved - unresolved;
+				if (job->jobs_left.fetch_sub(1) != 1) {
+					return;
+				}
+				pool.submit([job, cache] {
+					print_half_unresolved<Format>(job->function.name, sweep_kind, job->unresolved);
+					export_tile_sweep<Format>(
+						job->function.name, job->checksums, get_ISO8601Timestamp(), cache, job->key
+					);
+				}, true);
+			});
+		}
 	}
 }
 
-inline std::string get_ISO8601Timestamp() {
-	time_t now;
-	time(&now);
-	char buf[sizeof("2000-01-01T00:00:00Z")];
-	strftime(buf, sizeof(buf), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
-	std::string ret = buf;
-	return ret;
+/* the dense tables of Format. The sweeps are scheduled after every other table */
+template<typename Format>
+void schedule_half_tables(Job_Pool& pool, const Half_Requests& requests, Table_Cache* cache) {
+	schedule_dense_tables<Format>(pool, requests.dense, cache);
+	schedule_exact_dense_tables<Format>(pool, requests.f32_exact, cache);
+	schedule_exact_dense_tables<Format>(pool, requests.f64_exact, cache);
 }
 
-template<typename T>
-void export_table(
-	const Test_Gen<T>& table,
-	const std::vector<std::string>& input,
-	const std::vector<std::string>& output
-) {
-	std::string file_name = float_name<T>::fX;
-	file_name += "_";
-	file_name += table.table_name;
-	file_name += ".h";
-	std::string include_guard = file_name;
-	std::transform(include_guard.begin(), include_guard.end(), include_guard.begin(), ::toupper);
-	std::replace(include_guard.begin(), include_guard.end(), '.', '_');
-
-    FILE* file = fopen(file_name.c_str(), "wb");
-	if (file == nullptr) {
-		printf("Unable to open file \"%s\"\n", file_name.c_str());
-		return;
-	}
-	
-	/* begin */
-
-	fprintf(file, "#ifndef %s\n", include_guard.c_str());
-	fprintf(file, "#define %s\n\n", include_guard.c_str());
-	fprintf(file, "%s\n\n", table.headers.c_str());
-	
-	fprintf(file, "/* Generated %s */\n\n", get_ISO8601Timestamp().c_str());
-
-	fprintf(file, "typedef %s input_type;\n\n", table.input_type.c_str());
-	fprintf(file, "typedef %s output_type;\n\n", table.output_type.c_str());
-
-	/* input values */
-
-	fprintf(file,
-		"const input_type %s_%s_input[%zu] = {\n",
-		float_name<T>::fX, table.table_name.c_str(),
-		input.size()
+int main(int argc, char* argv[]) {
+	Gen_Options options;
+	int exit_code;
+	if (!parse_options(argc, argv, options, exit_code)) {
+		return exit_code;
+	}
+	std::vector<Gen_Options> jobs;
+	if (options.manifest.empty()) {
+		jobs.push_back(options);
+	} else if (!read_manifest(argv[0], options.manifest, options, jobs)) {
+		return 1;
+	}
+	const std::vector<Test_Gen<float>> f32_tests = get_test_list<float>();
+	const std::vector<Test_Gen<double>> f64_tests = get_test_list<double>();
+	const std::vector<Oracle_Function<1>> half_functions = half_unary_functions();
+	const std::vector<Exact_Dense_Function<float>> f32_exact =
+		exact_dense_functions(f32_tests, exact_dense_f32_tables);
+	const std::vector<Exact_Dense_Function<double>> f64_exact =
+		exact_dense_functions(f64_tests, exact_dense_f64_tables);
+	std::vector<std::string> dense_functions;
+	for (const Oracle_Function<1>& function : half_functions) {
+		dense_functions.push_back(function.name);
+	}
+	for (const Exact_Dense_Function<float>& function : f32_exact) {
+		dense_functions.push_back(function.name);
+	}
+	for (const Exact_Dense_Function<double>& function : f64_exact) {
+		dense_functions.push_back(function.name);
+	}
+	if (!check_table_names(jobs, f32_tests, f64_tests, dense_functions)) {
+		return 1;
+	}
+	Selected_Tables selected;
+	std::vector<Table_Request<float>> f32_requests;
+	std::vector<Table_Request<double>> f64_requests;
+	if (
+		!select_tables(f32_tests, jobs, selected, f32_requests) ||
+		!select_tables(f64_tests, jobs, selected, f64_requests)
+	) {
+		return 1;
+	}
+	const Half_Requests f16_requests = select_half_requests<Binary16>(
+		half_functions, f32_exact, f64_exact, jobs, options.exhaustive, selected
 	);
-	for (size_t i = 0; i < input.size(); i++) {
-		fprintf(file, "/* %4zu */ %s,\n", i, export_value(input[i]).c_str());
-	}
-	fprintf(file, "};\n\n");
-
-	/* output values */
-
-	fprintf(file,
-		"const output_type %s_%s_output[%zu] = {\n",
-		float_name<T>::fX, table.table_name.c_str(),
-		output.size()
+	const Half_Requests bf16_requests = select_half_requests<BFloat16>(
+		half_functions, f32_exact, f64_exact, jobs, options.exhaustive, selected
 	);
-	for (size_t i = 0; i < output.size(); i++) {
-		fprintf(file, "/* %4zu */ %s,\n", i, export_value(output[i]).c_str());
-	}
-	fprintf(file, "};\n\n");
-
-	/* end */
-
-	fprintf(file, "#endif /* %s */\n", include_guard.c_str());
-
-	fclose(file);
-	printf("Wrote file \"%s\"\n", file_name.c_str());
-}
-
-template<typename T>
-void generate_all_tests(void) {
-	const char* float_int_type = float_name<T>::int_type;
-	std::vector<Test_Gen<T>> Test_List;
-
-	{
-		Test_List.push_back(Test_Gen<T>(
-			generate_ilogb_test<T>,
-			"ilogb_LUT",
-			float_int_type,
-			"int",
-			"#include <stdint.h>\n#include <limits.h>\n#include <math.h>",
-			sizeof(T) + 3
-		));
-	}
-	{
-		Test_List.push_back(Test_Gen<T>(
-			generate_logb_test<T>,
-			"logb_LUT",
-			float_int_type,
-			float_int_type,
-			"#include <stdint.h>",
-			2 * sizeof(T)
-		));
-	}
-	{
-		std::string frexp_output_type = "struct { ";
-		frexp_output_type += float_int_type;
-		frexp_output_type += " frac; int expon; }";
-		Test_List.push_back(Test_Gen<T>(
-			generate_frexp_test<T>,
-			"frexp_LUT",
-			float_int_type,
-			frexp_output_type.c_str(),
-			"#include <stdint.h>\n#include <limits.h>\n#include <math.h>",
-			2 * sizeof(T) + 3
-		));
-	}
-	{
-		std::string ldexp_input_type = "struct { ";
-		ldexp_input_type += float_int_type;
-		ldexp_input_type += " value; int expon; }";
-		Test_List.push_back(Test_Gen<T>(
-			generate_ldexp_test<T>,
-			"ldexp_LUT",
-			ldexp_input_type.c_str(),
-			float_int_type,
-			"#include <stdint.h>",
-			2 * sizeof(T) + 3
-		));
-	}
-	{
-		std::string nextafter_input_type = "struct { ";
-		nextafter_input_type += float_int_type;
-		nextafter_input_type += " value; ";
-		nextafter_input_type += float_int_type;
-		nextafter_input_type += " target; }";
-		Test_List.push_back(Test_Gen<T>(
-			generate_nextafter_test<T>,
-			"nextafter_LUT",
-			nextafter_input_type.c_str(),
-			float_int_type,
-			"#include <stdint.h>",
-			3 * sizeof(T)
-		));
-	}
-	{
-		Test_List.push_back(Test_Gen<T>(
-			generate_sqrt_test<T>,
-			"sqrt_LUT",
-			float_int_type,
-			float_int_type,
-			"#include <stdint.h>",
-			2 * sizeof(T)
-		));
-	}
-	if (float_name<T>::type_bits != 32) {
-		Test_List.push_back(Test_Gen<T>(
-			generate_float_to_f32_test<T>,
-			"to_f32_LUT",
-			float_int_type,
-			"uint32_t",
-			"#include <stdint.h>",
-			sizeof(T) + sizeof(float)
-		));
-	}
-	if (float_name<T>::type_bits != 64) {
-		Test_List.push_back(Test_Gen<T>(
-			generate_float_to_f64_test<T>,
-			"to_f64_LUT",
-			float_int_type,
-			"uint64_t",
-			"#include <stdint.h>",
-			sizeof(T) + sizeof(double)
-		));
+	if (selected.empty()) {
+		printf("No tables selected\n");
 	}
-	{
-		Test_List.push_back(Test_Gen<T>(
-			generate_sqrt_test<T>,
-			"sqrt_LUT",
-			float_int_type,
-			float_int_type,
-			"#include <stdint.h>",
-			2 * sizeof(T)
-		));
-	}
-	{
-		std::string fma_input_type = "struct { ";
-		fma_input_type += float_int_type;
-		fma_input_type += " x; ";
-		fma_input_type += float_int_type;
-		fma_input_type += " y; ";
-		fma_input_type += float_int_type;
-		fma_input_type += " z; }";
-		Test_List.push_back(Test_Gen<T>(
-			generate_fma_test<T>,
-			"fma_LUT",
-			fma_input_type.c_str(),
-			float_int_type,
-			"#include <stdint.h>",
-			4 * sizeof(T)
-		));
+	unsigned formats = 0;
+	for (const Gen_Options& job : jobs) {
+		formats |= job.formats;
 	}
-	{
-		std::string modf_output_type = "struct { ";
-		modf_output_type += float_int_type;
-		modf_output_type += " frac_part; ";
-		modf_output_type += float_int_type;
-		modf_output_type += " trunc_part; }";
-		Test_List.push_back(Test_Gen<T>(
-			generate_modf_test<T>,
-			"modf_LUT",
-			float_int_type,
-			modf_output_type.c_str(),
-			"#include <stdint.h>",
-			3 * sizeof(T)
-		));
-	}
-	{
-		std::string rounding_output_type = "struct { ";
-		rounding_output_type += float_int_type;
-		rounding_output_type += " r_floor; ";
-		rounding_output_type += float_int_type;
-		rounding_output_type += " r_ceil; ";
-		rounding_output_type += float_int_type;
-		rounding_output_type += " r_round; }";
-		Test_List.push_back(Test_Gen<T>(
-			generate_rounding_test<T>,
-			"rounding_LUT",
-			float_int_type,
-			rounding_output_type.c_str(),
-			"#include <stdint.h>",
-			4 * sizeof(T)
-		));
+
+	if (!options.output_dir.empty()) {
+		std::error_code error;
+		if (!options.stats_json.empty()) {
+			options.stats_json = std::filesystem::absolute(options.stats_json, error).string();
+		}
+		std::filesystem::create_directories(options.output_dir, error);
+		if (!error) {
+			std::filesystem::current_path(options.output_dir, error);
+		}
+		if (error) {
+			printf("Unable to use directory \"%s\"\n", options.output_dir.c_str());
+			return 1;
+		}
 	}
-	{
-		std::string float_to_integer_output_type =
-			"struct { uint32_t u32; int32_t i32; uint64_t u64; int64_t i64; }";
-		Test_List.push_back(Test_Gen<T>(
-			generate_float_to_integer_test<T>,
-			"to_integer_LUT",
-			float_int_type,
-			float_to_integer_output_type.c_str(),
-			"#include <stdint.h>",
-			sizeof(T) + 2 * sizeof(uint32_t) + 2 * sizeof(uint64_t)
-		));
+	Table_Cache cache(Table_Cache::default_file_name);
+	cache.load();
+	cache.set_force(options.force);
+	if ((formats & format_binary) || options.exhaustive) {
+		export_binary_loader_source(&cache, get_ISO8601Timestamp());
+	}
+	if (formats & format_encoded) {
+		export_encoded_decoder_source(&cache, get_ISO8601Timestamp());
+	}
+	if (
+		!export_shared_inputs(f32_tests, f32_requests, &cache) ||
+		!export_shared_inputs(f64_tests, f64_requests, &cache)
+	) {
+		return 1;
+	}
+	std::atomic<bool> check_failed = false;
+	Stats_List stats_list;
+	Stats_List* stats = options.stats ? &stats_list : nullptr;
+	Job_Pool pool(options.jobs);
+	schedule_all_tests(pool, f32_requests, options.fuse, &cache, check_failed, stats);
+	schedule_all_tests(pool, f64_requests, options.fuse, &cache, check_failed, stats);
+	schedule_half_tables<Binary16>(pool, f16_requests, &cache);
+	schedule_half_tables<BFloat16>(pool, bf16_requests, &cache);
+	if (options.exhaustive) {
+		schedule_sweeps(pool, f32_requests, options.fuse, &cache, check_failed);
+		schedule_tile_sweeps<Binary16>(pool, f16_requests.sweeps, &cache);
+		schedule_tile_sweeps<BFloat16>(pool, bf16_requests.sweeps, &cache);
+	}
+	pool.wait();
+	if (options.stats) {
+		print_stats(stats_list);
+		if (
+			!options.stats_json.empty() &&
+			!write_stats_json(options.stats_json.c_str(), stats_list)
+		) {
+			return 1;
+		}
 	}
-	{
-		std::string float_from_integer_input_type =
-			"struct { uint32_t u32; uint64_t u64; }";
-		std::string float_from_integer_output_type = "struct { ";
-		float_from_integer_output_type += float_int_type;
-		float_from_integer_output_type += " fu32; ";
-		float_from_integer_output_type += float_int_type;
-		float_from_integer_output_type += " fi32; ";
-		float_from_integer_output_type += float_int_type;
-		float_from_integer_output_type += " fu64; ";
-		float_from_integer_output_type += float_int_type;
-		float_from_integer_output_type += " fi64; }";
-		Test_List.push_back(Test_Gen<T>(
-			generate_float_from_integer_test<T>,
-			"from_integer_LUT",
-			float_from_integer_input_type.c_str(),
-			float_from_integer_output_type.c_str(),
-			"#include <stdint.h>",
-			4 * sizeof(T) + sizeof(uint32_t) + sizeof(uint64_t)
-		));
+	if (!cache.save()) {
+		printf("Unable to save \"%s\"\n", Table_Cache::default_file_name);
+		return 1;
 	}
-
-	for (size_t i = 0; i < Test_List.size(); i++) {
-		size_t elem_count = 32768 / Test_List[i].element_size;
-		elem_count = std::min<size_t>(elem_count, 1024);
-		std::vector<std::string> input(elem_count);
-		std::vector<std::string> output(elem_count);
-		Test_List[i].generate(input, output);
-		export_table(Test_List[i], input, output);
+	if (check_failed) {
+		printf("Error: batched evaluation differs from scalar evaluation\n");
+		return 1;
 	}
-}
-
-int main(void) {
-	generate_all_tests<float>();
-	generate_all_tests<double>();
 	return 0;
 }
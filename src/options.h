@@ -0,0 +1,401 @@
+#ifndef OPTIONS_H
+#define OPTIONS_H
+
+#include <algorithm>
+#include <cerrno>
+#include <cinttypes>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* output formats, as a bitmask */
+enum Output_Format : unsigned {
+	format_header = 1 << 0,
+	format_binary = 1 << 1,
+	format_encoded = 1 << 2,
+	/* a C driver for each header table, which implies format_header */
+	format_driver = 1 << 3,
+	/* output only headers of the unary tables, sharing one header of inputs per type */
+	format_shared = 1 << 4,
+};
+
+/* float types of the tables, as a bitmask */
+enum Float_Type : unsigned {
+	type_f32 = 1 << 0,
+	type_f64 = 1 << 1,
+	/* binary16 and bfloat16, whose unary tables are dense over every input */
+	type_f16 = 1 << 2,
+	type_bf16 = 1 << 3,
+};
+
+struct Gen_Options {
+	/* number of worker threads */
+	size_t jobs = 1;
+	/* tables are a function of the seed, and not of the thread count */
+	uint64_t seed = 0;
+	/* regenerate and rewrite tables even if they are unchanged since the last run */
+	bool force = false;
+	unsigned formats = format_header;
+	/* rows per table, streamed in constant memory. 0 for the default sizes */
+	size_t count = 0;
+	/* size tables of several arguments to hold every combination of their edge cases */
+	bool edge_product = false;
+	/* also generate the _modes and _flags twins of the selected tables */
+	bool modes = false;
+	bool flags = false;
+	/* also checksum the unary float tables over every input */
+	bool exhaustive = false;
+	/* generate the input of the unary tables once, and evaluate them over it in one pass */
+	bool fuse = false;
+	/* compare batched (vector) evaluation bitwise against scalar evaluation */
+	bool check_vector = false;
+	/* candidate rows per table, reduced to a subset covering the same features. 0 to disable */
+	size_t minimize = 0;
+	/* print per table timings and counters */
+	bool stats = false;
+	/* also write them as JSON, if not empty */
+	std::string stats_json;
+	/* names of the tables to generate, such as ldexp, ldexp_LUT or f64_ldexp_LUT. Empty for all */
+	std::vector<std::string> tables;
+	unsigned types = type_f32 | type_f64;
+	/* directory the tables and the cache are written to, if not empty */
+	std::string output_dir;
+	/* file listing the jobs to run, one line of options each, if not empty */
+	std::string manifest;
+};
+
+inline void print_usage(const char* program) {
+	printf(
+		"Usage: %s [options]\n"
+		"  -j, --jobs <N>    number of worker threads (default: all cores)\n"
+		"  --seed <N>        random seed (default: 0)\n"
+		"  --force           regenerate and rewrite every table, ignoring the cache\n"
+		"  --count <N>       rows per table, streamed in constant memory (header format only)\n"
+		"  --edge-product    grow the tables of several arguments to hold every combination\n"
+		"                    of their edge cases, such as 64000 for fma, and random rows\n"
+		"                    after them. By default they keep at most 1024 rows, holding an\n"
+		"                    evenly spread subset of the combinations\n"
+		"  --modes           also generate the tables evaluated in each rounding mode, such\n"
+		"                    as sqrt_modes_LUT, for the selected tables that have them\n"
+		"  --flags           also generate the tables recording the exception flags raised,\n"
+		"                    such as sqrt_flags_LUT, for the selected tables that have them\n"
+		"  --format <list>   comma separated output formats: header, binary, encoded,\n"
+		"                    driver (a C test and benchmark driver per header), shared\n"
+		"                    (output only headers of the unary tables, with the inputs\n"
+		"                    in one f32_unary_inputs.h and f64_unary_inputs.h)\n"
+		"                    (default: header)\n"
+		"  --exhaustive      also sweep the unary f32 tables over all 2^32 inputs, and the\n"
+		"                    binary f16 and bf16 tables over all 2^32 pairs\n"
+		"  --fuse            generate one input for the unary tables of each type and size,\n"
+		"                    and evaluate every such table over it in a single blocked pass\n"
+		"  --check-vector    verify vector kernels bitwise against scalar libm, failing on mismatch\n"
+		"  --minimize <N>    generate N candidate rows per table, and only export the smallest\n"
+		"                    subset found that covers the same classes, exponent bands, ties,\n"
+		"                    and integer overflow regions\n"
+		"  --stats           print per table stage timings, throughput, bytes and peak memory\n"
+		"  --stats-json <f>  --stats, also writing the results as JSON to f\n"
+		"  --table <list>    comma separated tables to generate, such as ldexp or f64_ldexp_LUT\n"
+		"                    (default: all)\n"
+		"  --type <list>     comma separated float types: f32, f64, f16 (binary16) and bf16\n"
+		"                    (bfloat16) (default: f32,f64). f16 and bf16 have a dense table\n"
+		"                    over every input, such as f16_exp_dense.h, for each unary\n"
+		"                    table, without the _modes and _flags variants. Tables of\n"
+		"                    several inputs, such as fma, ldexp or nextafter, have none,\n"
+		"                    and pow, atan2 and hypot are swept with --exhaustive\n"
+		"  -o, --output <d>  directory to write the tables and the cache to (default: .)\n"
+		"  --manifest <f>    run the jobs listed in f, one per line, each given by --table,\n"
+		"                    --type, --count, --edge-product, --modes, --flags, --seed,\n"
+		"                    --format and --minimize options that override the command line.\n"
+		"                    # starts a comment. Jobs generating the same table are only\n"
+		"                    run once\n"
+		"  -h, --help        show this message\n",
+		program
+	);
+}
+
+/* upper bounds of the numeric options */
+constexpr uint64_t max_jobs = 1024;
+/* rows per table, and candidate rows for --minimize */
+constexpr uint64_t max_count = UINT64_C(1) << 30;
+
+/* parses a decimal integer in [0, max] */
+inline bool parse_integer_option(
+	const char* name, const char* text, uint64_t max, uint64_t& value
+) {
+	if (text == nullptr || *text == '\0') {
+		printf("Error: %s expects a value\n", name);
+		return false;
+	}
+	char* end = nullptr;
+	errno = 0;
+	unsigned long long parsed = strtoull(text, &end, 10);
+	/* strtoull also skips white space and accepts signs */
+	if (*end != '\0' || text[0] < '0' || text[0] > '9') {
+		printf("Error: invalid value \"%s\" for %s\n", text, name);
+		return false;
+	}
+	if (errno == ERANGE || parsed > max) {
+		printf("Error: %s must be at most %" PRIu64 ", not \"%s\"\n", name, max, text);
+		return false;
+	}
+	value = static_cast<uint64_t>(parsed);
+	return true;
+}
+
+inline bool parse_size_option(const char* name, const char* text, uint64_t max, size_t& value) {
+	uint64_t parsed;
+	if (!parse_integer_option(name, text, max, parsed)) {
+		return false;
+	}
+	value = static_cast<size_t>(parsed);
+	return true;
+}
+
+/* splits a comma separated list */
+inline std::vector<std::string> split_list(const char* text) {
+	std::vector<std::string> items;
+	std::string list = text;
+	size_t pos = 0;
+	while (pos <= list.size()) {
+		size_t end = std::min(list.find(',', pos), list.size());
+		items.push_back(list.substr(pos, end - pos));
+		pos = end + 1;
+	}
+	return items;
+}
+
+inline bool parse_type_option(const char* name, const char* text, unsigned& types) {
+	if (text == nullptr || *text == '\0') {
+		printf("Error: %s expects a value\n", name);
+		return false;
+	}
+	types = 0;
+	for (const std::string& type : split_list(text)) {
+		if (type == "f32") {
+			types |= type_f32;
+		} else if (type == "f64") {
+			types |= type_f64;
+		} else if (type == "f16") {
+			types |= type_f16;
+		} else if (type == "bf16") {
+			types |= type_bf16;
+		} else {
+			printf("Error: unknown type \"%s\" for %s\n", type.c_str(), name);
+			return false;
+		}
+	}
+	return true;
+}
+
+inline bool parse_format_option(const char* name, const char* text, unsigned& formats) {
+	if (text == nullptr || *text == '\0') {
+		printf("Error: %s expects a value\n", name);
+		return false;
+	}
+	formats = 0;
+	for (const std::string& format : split_list(text)) {
+		if (format == "header") {
+			formats |= format_header;
+		} else if (format == "binary") {
+			formats |= format_binary;
+		} else if (format == "encoded") {
+			formats |= format_encoded;
+		} else if (format == "driver") {
+			formats |= format_header | format_driver;
+		} else if (format == "shared") {
+			formats |= format_shared;
+		} else {
+			printf("Error: unknown format \"%s\" for %s\n", format.c_str(), name);
+			return false;
+		}
+	}
+	return true;
+}
+
+/* options that apply to a single job, and may be given by each line of a manifest */
+inline bool is_job_option(const char* arg) {
+	for (const char* option : {
+		"--table", "--type", "--count", "--edge-product", "--modes", "--flags", "--seed",
+		"--format", "--minimize"
+	}) {
+		if (strcmp(arg, option) == 0) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/*
+** Parses args into options. Only job options are accepted in a manifest.
+** @returns false if the program should exit, setting exit_code to 0 for
+** --help and to 1 for invalid arguments
+*/
+inline bool parse_arguments(
+	const char* program, const std::vector<const char*>& args, bool manifest,
+	Gen_Options& options, int& exit_code
+) {
+	exit_code = 1;
+	for (size_t i = 0; i < args.size(); i++) {
+		const char* arg = args[i];
+		const char* next = (i + 1 < args.size()) ? args[i + 1] : nullptr;
+		if (manifest && !is_job_option(arg)) {
+			printf("Error: \"%s\" is not a job option, and cannot be used in a manifest\n", arg);
+			return false;
+		}
+		if (strcmp(arg, "-h") == 0 || strcmp(arg, "--help") == 0) {
+			print_usage(program);
+			exit_code = 0;
+			return false;
+		} else if (strcmp(arg, "-j") == 0 || strcmp(arg, "--jobs") == 0) {
+			if (!parse_size_option(arg, next, max_jobs, options.jobs)) {
+				return false;
+			}
+			i++;
+		} else if (strcmp(arg, "--force") == 0) {
+			options.force = true;
+		} else if (strcmp(arg, "--count") == 0) {
+			if (!parse_size_option(arg, next, max_count, options.count)) {
+				return false;
+			}
+			i++;
+		} else if (strcmp(arg, "--edge-product") == 0) {
+			options.edge_product = true;
+		} else if (strcmp(arg, "--modes") == 0) {
+			options.modes = true;
+		} else if (strcmp(arg, "--flags") == 0) {
+			options.flags = true;
+		} else if (strcmp(arg, "--check-vector") == 0) {
+			options.check_vector = true;
+		} else if (strcmp(arg, "--minimize") == 0) {
+			if (!parse_size_option(arg, next, max_count, options.minimize)) {
+				return false;
+			}
+			i++;
+		} else if (strcmp(arg, "--stats") == 0) {
+			options.stats = true;
+		} else if (
+			strcmp(arg, "--stats-json") == 0 || strcmp(arg, "--table") == 0 ||
+			strcmp(arg, "-o") == 0 || strcmp(arg, "--output") == 0 ||
+			strcmp(arg, "--manifest") == 0
+		) {
+			if (next == nullptr || *next == '\0') {
+				printf("Error: %s expects a value\n", arg);
+				return false;
+			}
+			if (strcmp(arg, "--stats-json") == 0) {
+				options.stats = true;
+				options.stats_json = next;
+			} else if (strcmp(arg, "--table") == 0) {
+				options.tables = split_list(next);
+			} else if (strcmp(arg, "--manifest") == 0) {
+				options.manifest = next;
+			} else {
+				options.output_dir = next;
+			}
+			i++;
+		} else if (strcmp(arg, "--type") == 0) {
+			if (!parse_type_option(arg, next, options.types)) {
+				return false;
+			}
+			i++;
+		} else if (strcmp(arg, "--exhaustive") == 0) {
+			options.exhaustive = true;
+		} else if (strcmp(arg, "--fuse") == 0) {
+			options.fuse = true;
+		} else if (strcmp(arg, "--format") == 0) {
+			if (!parse_format_option(arg, next, options.formats)) {
+				return false;
+			}
+			i++;
+		} else if (strcmp(arg, "--seed") == 0) {
+			if (!parse_integer_option(arg, next, UINT64_MAX, options.seed)) {
+				return false;
+			}
+			i++;
+		} else if (strncmp(arg, "-j", 2) == 0) {
+			if (!parse_size_option("-j", arg + 2, max_jobs, options.jobs)) {
+				return false;
+			}
+		} else {
+			printf("Error: unknown option \"%s\"\n", arg);
+			print_usage(program);
+			return false;
+		}
+	}
+	if (options.count != 0 && (options.formats & ~(format_header | format_driver)) != 0) {
+		printf("Error: --count only supports --format header and driver\n");
+		return false;
+	}
+	if ((options.formats & format_shared) && options.minimize != 0) {
+		printf("Error: --minimize selects rows per table, so it cannot share inputs\n");
+		return false;
+	}
+	if (options.count != 0 && options.minimize != 0) {
+		printf("Error: --count and --minimize cannot be combined\n");
+		return false;
+	}
+	if (options.jobs == 0) {
+		printf("Error: --jobs must be at least 1\n");
+		return false;
+	}
+	exit_code = 0;
+	return true;
+}
+
+inline bool parse_options(int argc, char* argv[], Gen_Options& options, int& exit_code) {
+	options.jobs = std::max(1u, std::thread::hardware_concurrency());
+	const std::vector<const char*> args(argv + 1, argv + argc);
+	return parse_arguments(argv[0], args, false, options, exit_code);
+}
+
+/*
+** Reads the jobs of a manifest, each line overriding the job options of
+** defaults. For example:
+**   # iterate on ldexp
+**   --table ldexp --type f64 --count 65536
+**   --table sqrt,fma --format header,binary --seed 7
+** @returns false on error
+*/
+inline bool read_manifest(
+	const char* program, const std::string& file_name, const Gen_Options& defaults,
+	std::vector<Gen_Options>& jobs
+) {
+	std::ifstream file(file_name);
+	if (!file) {
+		printf("Unable to open file \"%s\"\n", file_name.c_str());
+		return false;
+	}
+	std::string line;
+	for (size_t line_number = 1; std::getline(file, line); line_number++) {
+		line = line.substr(0, line.find('#'));
+		std::istringstream stream(line);
+		std::vector<std::string> words;
+		for (std::string word; stream >> word;) {
+			words.push_back(word);
+		}
+		if (words.empty()) {
+			continue;
+		}
+		std::vector<const char*> args;
+		for (const std::string& word : words) {
+			args.push_back(word.c_str());
+		}
+		Gen_Options job = defaults;
+		int exit_code;
+		if (!parse_arguments(program, args, true, job, exit_code)) {
+			printf("Error: in \"%s\" line %zu\n", file_name.c_str(), line_number);
+			return false;
+		}
+		jobs.push_back(job);
+	}
+	return true;
+}
+
+#endif /* OPTIONS_H */
@@ -1,51 +1,93 @@
 #ifndef RANDOM_GEN_H
 #define RANDOM_GEN_H
 
+#include <array>
 #include <bit>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <cstdio>
-#include <random>
-#include <vector>
+#include <limits>
+#include <span>
 
 #include "edge_cases.h"
+#include "table_columns.hpp"
 
-template <typename T>
-void random_gen_basic(std::vector<T>& values, size_t offset = 0);
-
-template <>
-inline void random_gen_basic(std::vector<float>& values, size_t offset) {
-	if (offset >= values.size()) {
-		printf("Error: Offset %zu exceeds size of %zu\n", offset, values.size());
-		return;
-	}
-	std::random_device rd;
-	std::mt19937 gen(rd());
-	std::uniform_int_distribution<uint32_t> dist;
-	
-	for (size_t i = offset; i < values.size(); i++) {
-		float temp;
-		do {
-			temp = std::bit_cast<float>(dist(gen));
-		} while(!std::isfinite(temp));
-		values[i] = temp;
+/*
+** Philox4x32-10 (Salmon et al., "Parallel Random Numbers: As Easy as
+** 1, 2, 3"). Every output depends only on the key and the counter, so
+** element i of a table can be drawn without drawing elements 0 to i - 1.
+*/
+inline std::array<uint32_t, 4> philox4x32(
+	std::array<uint32_t, 4> ctr, std::array<uint32_t, 2> key
+) {
+	constexpr uint32_t M0 = UINT32_C(0xD2511F53);
+	constexpr uint32_t M1 = UINT32_C(0xCD9E8D57);
+	constexpr uint32_t W0 = UINT32_C(0x9E3779B9);
+	constexpr uint32_t W1 = UINT32_C(0xBB67AE85);
+	for (int round = 0; round < 10; round++) {
+		uint64_t p0 = static_cast<uint64_t>(M0) * ctr[0];
+		uint64_t p1 = static_cast<uint64_t>(M1) * ctr[2];
+		ctr = {
+			static_cast<uint32_t>(p1 >> 32) ^ ctr[1] ^ key[0],
+			static_cast<uint32_t>(p1),
+			static_cast<uint32_t>(p0 >> 32) ^ ctr[3] ^ key[1],
+			static_cast<uint32_t>(p0),
+		};
+		key[0] += W0;
+		key[1] += W1;
 	}
+	return ctr;
 }
 
-template <>
-inline void random_gen_basic(std::vector<double>& values, size_t offset) {
-	std::random_device rd;
-	std::mt19937_64 gen(rd());
-	std::uniform_int_distribution<uint64_t> dist;
-
-	for (size_t i = offset; i < values.size(); i++) {
-		double temp;
-		do {
-			temp = std::bit_cast<double>(dist(gen));
-		} while(!std::isfinite(temp));
-		values[i] = temp;
+/*
+** Independent streams for each quantity a generator draws. Tables that
+** draw the same quantity from the same stream get the same values, which
+** keeps the inputs of the unary tables identical.
+*/
+enum Random_Stream_Id : uint32_t {
+	stream_value = 1,
+	stream_target,
+	stream_expon,
+	stream_x,
+	stream_y,
+	stream_z,
+	stream_u32,
+	stream_u64,
+};
+
+struct Random_Stream {
+	uint64_t seed;
+	uint32_t stream;
+
+	/* draw `attempt` of element `index` */
+	uint64_t bits(uint64_t index, uint32_t attempt = 0) const {
+		std::array<uint32_t, 4> ret = philox4x32(
+			{
+				static_cast<uint32_t>(index), static_cast<uint32_t>(index >> 32),
+				attempt, stream
+			},
+			{ static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32) }
+		);
+		return (static_cast<uint64_t>(ret[1]) << 32) | ret[0];
 	}
+};
+
+/* uniformly random integer in [low, high] */
+inline int64_t random_int(const Random_Stream& rng, uint64_t index, int64_t low, int64_t high) {
+	uint64_t range = static_cast<uint64_t>(high - low) + 1;
+	uint64_t offset = static_cast<uint64_t>(
+		(static_cast<unsigned __int128>(rng.bits(index)) * range) >> 64
+	);
+	return low + static_cast<int64_t>(offset);
+}
+
+/* uniformly random real in [low, high) */
+template<typename T>
+inline T random_real(const Random_Stream& rng, uint64_t index, T low, T high) {
+	constexpr int digits = std::numeric_limits<T>::digits;
+	T unit = static_cast<T>(rng.bits(index) >> (64 - digits)) * std::ldexp(static_cast<T>(1.0), -digits);
+	return low + (high - low) * unit;
 }
 
 #endif /* RANDOM_GEN_H */
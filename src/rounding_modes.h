@@ -0,0 +1,92 @@
+#ifndef ROUNDING_MODES_H
+#define ROUNDING_MODES_H
+
+#include <array>
+#include <cfenv>
+#include <cstddef>
+#include <set>
+#include <string>
+
+#include "table_columns.hpp"
+#include "test_gen.hpp"
+
+/*
+** Rounding mode tables repeat the output columns of a table once for each
+** rounding mode, evaluated over the same inputs. The rounding mode is only
+** switched between modes, so each mode evaluates every row of a slice in
+** one block, and all four modes cost about four times one mode. The
+** fesetround calls are opaque, so the loads and stores of the rows of a
+** block cannot be moved across them.
+*/
+inline constexpr std::array<int, 4> rounding_modes = {
+	FE_TONEAREST, FE_UPWARD, FE_DOWNWARD, FE_TOWARDZERO
+};
+
+/* suffixes of the fields of each mode, in the order of rounding_modes */
+inline constexpr std::array<const char*, 4> rounding_mode_names = {
+	"nearest", "upward", "downward", "towardzero"
+};
+
+/*
+** Field names that outlive the layouts built from them, such as sqrt
+** "upward" or rounding "r_floor_upward". Only called while building the
+** test lists, before any jobs run.
+*/
+inline const char* field_name(const std::string& name) {
+	static std::set<std::string> names;
+	return names.insert(name).first->c_str();
+}
+
+/* the fields of layout, once for each of rounding_modes */
+inline Record_Layout rounding_mode_layout(const Record_Layout& layout) {
+	Record_Layout modes = {};
+	for (const char* mode : rounding_mode_names) {
+		for (const Field& field : layout.fields) {
+			const std::string name = (field.name == nullptr) ?
+				std::string(mode) : std::string(field.name) + "_" + mode;
+			modes.fields.push_back({field.kind, field_name(name)});
+		}
+	}
+	return modes;
+}
+
+/* restores the rounding mode of the calling thread when it goes out of scope */
+class Rounding_Mode_Scope {
+public:
+	Rounding_Mode_Scope() : saved(std::fegetround()) {}
+	Rounding_Mode_Scope(const Rounding_Mode_Scope&) = delete;
+	Rounding_Mode_Scope& operator=(const Rounding_Mode_Scope&) = delete;
+
+	~Rounding_Mode_Scope() {
+		std::fesetround(saved);
+	}
+
+private:
+	int saved;
+};
+
+/*
+** Evaluates rows [begin, end) in each of rounding_modes, into the columns of
+** that mode. Other slices of the table are evaluated into the same columns
+** concurrently, so each mode is evaluated over a copy of the rows into
+** scratch columns, which are copied into rows [begin, end) of its columns.
+*/
+template<Evaluate_Function evaluate>
+inline void evaluate_rounding_modes(
+	const Record_Columns& input,
+	Record_Columns& output,
+	size_t begin, size_t end
+) {
+	const size_t fields = output.columns.size() / rounding_modes.size();
+	const size_t rows = end - begin;
+	const Record_Columns slice_input = copy_records(input, begin, end);
+	Record_Columns mode_output = scratch_records(output, 0, fields, rows);
+	Rounding_Mode_Scope scope;
+	for (size_t m = 0; m < rounding_modes.size(); m++) {
+		std::fesetround(rounding_modes[m]);
+		evaluate(slice_input, mode_output, 0, rows);
+		store_records(mode_output, output, m * fields, begin);
+	}
+}
+
+#endif /* ROUNDING_MODES_H */
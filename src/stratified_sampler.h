@@ -0,0 +1,197 @@
+#ifndef STRATIFIED_SAMPLER_H
+#define STRATIFIED_SAMPLER_H
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <vector>
+
+#include "edge_cases.h"
+#include "random_gen.h"
+#include "table_columns.hpp"
+
+/*
+** Bit patterns mapped to integers in the order of the values they encode,
+** so that -0 and +0 are adjacent (-1 and 0) and each finite value is one
+** greater than the value below it.
+*/
+template<typename T>
+inline int64_t ordered_from_bits(float_bits<T> bits) {
+	constexpr float_bits<T> sign_mask = float_bits<T>(1) << (sizeof(T) * CHAR_BIT - 1);
+	if (bits & sign_mask) {
+		return -1 - static_cast<int64_t>(bits & ~sign_mask);
+	}
+	return static_cast<int64_t>(bits);
+}
+
+template<typename T>
+inline float_bits<T> bits_from_ordered(int64_t ordered) {
+	constexpr float_bits<T> sign_mask = float_bits<T>(1) << (sizeof(T) * CHAR_BIT - 1);
+	if (ordered < 0) {
+		return static_cast<float_bits<T>>(-1 - ordered) | sign_mask;
+	}
+	return static_cast<float_bits<T>>(ordered);
+}
+
+template<typename T>
+inline int64_t ordered_value(T x) {
+	return ordered_from_bits<T>(to_bits(x));
+}
+
+/* an inclusive range of ordered integers */
+struct Ordered_Range {
+	int64_t low;
+	int64_t high;
+};
+
+/* every finite value */
+template<typename T>
+inline std::vector<Ordered_Range> finite_ranges() {
+	const T max = std::numeric_limits<T>::max();
+	return {{ordered_value(-max), ordered_value(max)}};
+}
+
+/* [low, high], such as [1, nextdown(2)] for [1, 2) */
+template<typename T>
+inline std::vector<Ordered_Range> value_ranges(T low, T high) {
+	return {{ordered_value(low), ordered_value(high)}};
+}
+
+/* nonzero subnormals of either sign */
+template<typename T>
+inline std::vector<Ordered_Range> subnormal_ranges() {
+	const T low = std::numeric_limits<T>::denorm_min();
+	const T high = nextdown(std::numeric_limits<T>::min());
+	return {{ordered_value(-high), ordered_value(-low)}, {ordered_value(low), ordered_value(high)}};
+}
+
+/* finite values with |x| > bound */
+template<typename T>
+inline std::vector<Ordered_Range> magnitude_above_ranges(T bound) {
+	const T max = std::numeric_limits<T>::max();
+	return {
+		{ordered_value(-max), ordered_value(nextdown(-bound))},
+		{ordered_value(nextup(bound)), ordered_value(max)}
+	};
+}
+
+/*
+** Draws finite values from a union of ordered integer ranges without
+** rejection. The ranges are split into strata of one sign and exponent,
+** and row i draws uniformly from stratum (i * stride) % strata, so any
+** strata consecutive rows give every stratum exactly one value, and
+** fewer rows are spread evenly across the strata. Each stream uses its
+** own stride, so the inputs of a multi-input table are not drawn from
+** matching strata.
+*/
+template<typename T>
+class Stratified_Sampler {
+public:
+	explicit Stratified_Sampler(const std::vector<Ordered_Range>& ranges) {
+		constexpr int mant_bits = std::numeric_limits<T>::digits - 1;
+		const int64_t finite_low = ordered_value(-std::numeric_limits<T>::max());
+		const int64_t finite_high = ordered_value(std::numeric_limits<T>::max());
+		for (const Ordered_Range& range : ranges) {
+			int64_t low = std::max(range.low, finite_low);
+			const int64_t high = std::min(range.high, finite_high);
+			while (low <= high) {
+				int64_t end;
+				if (low >= 0) {
+					end = ((low >> mant_bits) + 1) * (int64_t(1) << mant_bits) - 1;
+				} else {
+					end = -1 - (((-1 - low) >> mant_bits) << mant_bits);
+				}
+				end = std::min(end, high);
+				strata.push_back({low, end});
+				low = end + 1;
+			}
+		}
+		std::sort(strata.begin(), strata.end(), [](const Ordered_Range& a, const Ordered_Range& b) {
+			return a.low < b.low;
+		});
+		if (strata.empty()) {
+			strata.push_back({0, 0});
+		}
+		const uint64_t count = strata.size();
+		for (size_t s = 0; s < strides.size(); s++) {
+			/* close to a multiple of the golden ratio, so that prefixes are well spread */
+			double fraction = std::fmod(0.6180339887498949 * static_cast<double>(s + 1), 1.0);
+			uint64_t stride = std::max<uint64_t>(
+				static_cast<uint64_t>(fraction * static_cast<double>(count)), 1
+			);
+			while (std::gcd(stride, count) != 1) {
+				stride++;
+			}
+			strides[s] = stride % count;
+		}
+	}
+
+	size_t stratum_count() const {
+		return strata.size();
+	}
+
+	float_bits<T> sample(const Random_Stream& rng, uint64_t index) const {
+		return sample_stratum(rng, index, stratum_of(rng, index));
+	}
+
+	/*
+	** Same as sample(rng, first_index + i) for each i, stepping the stratum
+	** instead of dividing for every value.
+	*/
+	void fill(
+		std::span<float_bits<T>> values, const Random_Stream& rng, uint64_t first_index
+	) const {
+		const size_t count = strata.size();
+		const size_t stride = strides[rng.stream % strides.size()];
+		size_t stratum = stratum_of(rng, first_index);
+		for (size_t i = 0; i < values.size(); i++) {
+			values[i] = sample_stratum(rng, first_index + i, stratum);
+			stratum += stride;
+			if (stratum >= count) {
+				stratum -= count;
+			}
+		}
+	}
+
+private:
+	size_t stratum_of(const Random_Stream& rng, uint64_t index) const {
+		const uint64_t count = strata.size();
+		return static_cast<size_t>(((index % count) * strides[rng.stream % strides.size()]) % count);
+	}
+
+	float_bits<T> sample_stratum(const Random_Stream& rng, uint64_t index, size_t s) const {
+		const Ordered_Range& stratum = strata[s];
+		const uint64_t range = static_cast<uint64_t>(stratum.high - stratum.low) + 1;
+		const uint64_t offset = static_cast<uint64_t>(
+			(static_cast<unsigned __int128>(rng.bits(index)) * range) >> 64
+		);
+		return bits_from_ordered<T>(stratum.low + static_cast<int64_t>(offset));
+	}
+
+	std::vector<Ordered_Range> strata;
+	std::array<uint64_t, 16> strides;
+};
+
+/* every finite value, stratified by sign and exponent */
+template<typename T>
+inline const Stratified_Sampler<T>& finite_sampler() {
+	static const Stratified_Sampler<T> sampler(finite_ranges<T>());
+	return sampler;
+}
+
+/* fills values[i] with element first_index + i of a stratified sampler */
+template<typename T>
+inline void random_gen_stratified(
+	std::span<float_bits<T>> values, const Random_Stream& rng, uint64_t first_index,
+	const Stratified_Sampler<T>& sampler = finite_sampler<T>()
+) {
+	sampler.fill(values, rng, first_index);
+}
+
+#endif /* STRATIFIED_SAMPLER_H */
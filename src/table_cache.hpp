@@ -0,0 +1,302 @@
+#ifndef TABLE_CACHE_HPP
+#define TABLE_CACHE_HPP
+
+#include <bit>
+#include <chrono>
+#include <cinttypes>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "correct_round.h"
+#include "edge_cases.h"
+#include "table_writer.h"
+
+/* a fast 64bit hash for change detection, not for security */
+inline uint64_t hash_bytes(const void* data, size_t size, uint64_t hash = 0) {
+	constexpr uint64_t prime = UINT64_C(0x9E3779B97F4A7C15);
+	const unsigned char* ptr = static_cast<const unsigned char*>(data);
+	hash ^= size * prime;
+	for (; size >= 8; size -= 8, ptr += 8) {
+		uint64_t word;
+		std::memcpy(&word, ptr, 8);
+		hash = (std::rotl(hash, 29) ^ word) * prime;
+	}
+	uint64_t tail = 0;
+	std::memcpy(&tail, ptr, size);
+	hash = (std::rotl(hash, 29) ^ tail) * prime;
+	hash ^= hash >> 32;
+	hash *= prime;
+	return hash ^ (hash >> 29);
+}
+
+inline uint64_t hash_string(const std::string& text, uint64_t hash = 0) {
+	return hash_bytes(text.data(), text.size(), hash);
+}
+
+template<typename T>
+inline uint64_t hash_value(const T& value, uint64_t hash = 0) {
+	return hash_bytes(&value, sizeof(value), hash);
+}
+
+template<typename T>
+inline uint64_t libm_fingerprint_of(uint64_t hash) {
+	for (T x : edge_cases<T>) {
+		int expon;
+		T integral_part;
+		hash = hash_value(std::sqrt(x), hash);
+		hash = hash_value(std::logb(x), hash);
+		hash = hash_value(std::ilogb(x), hash);
+		hash = hash_value(std::frexp(x, &expon), hash);
+		hash = hash_value(expon, hash);
+		hash = hash_value(std::ldexp(x, -3), hash);
+		hash = hash_value(std::modf(x, &integral_part), hash);
+		hash = hash_value(integral_part, hash);
+		hash = hash_value(std::floor(x), hash);
+		hash = hash_value(std::ceil(x), hash);
+		hash = hash_value(std::round(x), hash);
+		hash = hash_value(std::fma(x, x, x), hash);
+		hash = hash_value(std::nextafter(x, static_cast<T>(1.0)), hash);
+	}
+	/* the second operand cycles through the edge cases, so that the pairs stay linear */
+	for (size_t i = 0; i < edge_cases<T>.size(); i++) {
+		const T x = edge_cases<T>[i];
+		const T y = edge_cases<T>[(i * 7 + 3) % edge_cases<T>.size()];
+		int quotient;
+		hash = hash_value(std::fmod(x, y), hash);
+		hash = hash_value(std::remainder(x, y), hash);
+		hash = hash_value(std::remquo(x, y, &quotient), hash);
+		hash = hash_value(quotient, hash);
+		hash = hash_value(std::fmin(x, y), hash);
+		hash = hash_value(std::fmax(x, y), hash);
+	}
+	return hash;
+}
+
+/*
+** Results of the oracle functions in format W, which the correctly rounded
+** tables depend on. Without libquadmath, W is never __float128
+*/
+template<typename W>
+inline uint64_t oracle_fingerprint_of(uint64_t hash) {
+	/* the x87 long double is 10 bytes, padded with bytes of no value */
+	constexpr size_t size = (std::numeric_limits<W>::digits == 64) ? 10 : sizeof(W);
+	auto hash_result = [&](W y) {
+		hash = hash_bytes(&y, size, hash);
+	};
+	for (size_t i = 0; i < edge_cases<double>.size(); i++) {
+		const double x = edge_cases<double>[i];
+		const double y = edge_cases<double>[(i * 7 + 3) % edge_cases<double>.size()];
+		for (const Oracle_Function<1>& function : oracle_functions) {
+			hash_result(function.template evaluate<W>(x));
+		}
+		for (const Oracle_Function<2>& function : oracle_binary_functions) {
+			hash_result(function.template evaluate<W>(x, y));
+		}
+	}
+	return hash;
+}
+
+/*
+** Results of the host libm over the edge cases, for every libm function
+** the tables evaluate, including the oracle functions in each format the
+** oracle escalates to. A different libm that changes any table output is
+** expected to change this as well.
+*/
+inline uint64_t libm_fingerprint() {
+	static const uint64_t fingerprint = [] {
+		uint64_t hash = libm_fingerprint_of<double>(libm_fingerprint_of<float>(0));
+		hash = oracle_fingerprint_of<double>(hash);
+		hash = oracle_fingerprint_of<long double>(hash);
+		#ifdef TEST_GEN_QUADMATH
+			hash = oracle_fingerprint_of<oracle_quad>(hash);
+		#endif
+		return hash;
+	}();
+	return fingerprint;
+}
+
+struct Cache_Entry {
+	/* hash of everything that determines the table */
+	uint64_t key = 0;
+	/* hash of the file contents, excluding the generation timestamp */
+	uint64_t content = 0;
+	uint64_t file_size = 0;
+	std::string timestamp;
+	/* last write time of the file, so that a file edited in place is regenerated */
+	int64_t modified = 0;
+};
+
+/*
+** A sidecar manifest recording what each output file was generated from.
+** Tables whose key is unchanged are neither regenerated nor rewritten, and
+** regenerated tables whose contents are unchanged are not rewritten, so
+** the timestamps of unchanged files (and the builds depending on them)
+** are left alone.
+*/
+class Table_Cache {
+public:
+	static constexpr const char* default_file_name = ".test_gen_cache";
+
+	explicit Table_Cache(std::string manifest_file) : manifest_name(std::move(manifest_file)) {}
+
+	/* treat every table as stale, while still recording the new entries */
+	void set_force(bool force_stale) {
+		force = force_stale;
+	}
+
+	void load() {
+		FILE* file = fopen(manifest_name.c_str(), "rb");
+		if (file == nullptr) {
+			return;
+		}
+		char name[512];
+		char timestamp[64];
+		Cache_Entry entry;
+		while (fscanf(
+			file,
+			"%511s key=%" SCNx64 " content=%" SCNx64 " size=%" SCNu64 " generated=%63s"
+			" modified=%" SCNd64,
+			name, &entry.key, &entry.content, &entry.file_size, timestamp, &entry.modified
+		) == 6) {
+			entry.timestamp = timestamp;
+			entries[name] = entry;
+		}
+		fclose(file);
+	}
+
+	bool save() const {
+		std::lock_guard<std::mutex> lock(mutex);
+		std::string temp_name = manifest_name + ".tmp";
+		FILE* file = fopen(temp_name.c_str(), "wb");
+		if (file == nullptr) {
+			printf("Unable to open file \"%s\"\n", temp_name.c_str());
+			return false;
+		}
+		for (const auto& [name, entry] : entries) {
+			fprintf(
+				file,
+				"%s key=%016" PRIx64 " content=%016" PRIx64 " size=%" PRIu64 " generated=%s"
+				" modified=%" PRId64 "\n",
+				name.c_str(), entry.key, entry.content, entry.file_size, entry.timestamp.c_str(),
+				entry.modified
+			);
+		}
+		fclose(file);
+		return rename(temp_name.c_str(), manifest_name.c_str()) == 0;
+	}
+
+	/* true if file_name exists and was generated from the same key */
+	bool is_fresh(const std::string& file_name, uint64_t key) const {
+		Cache_Entry entry;
+		if (force || !find(file_name, entry) || entry.key != key) {
+			return false;
+		}
+		return file_matches(file_name, entry);
+	}
+
+	/* true if file_name exists with the same contents */
+	bool has_content(const std::string& file_name, uint64_t content) const {
+		Cache_Entry entry;
+		if (force || !find(file_name, entry) || entry.content != content) {
+			return false;
+		}
+		return file_matches(file_name, entry);
+	}
+
+	bool find(const std::string& file_name, Cache_Entry& entry) const {
+		std::lock_guard<std::mutex> lock(mutex);
+		auto iter = entries.find(file_name);
+		if (iter == entries.end()) {
+			return false;
+		}
+		entry = iter->second;
+		return true;
+	}
+
+	/* records entry for file_name, as last written now */
+	void update(const std::string& file_name, const Cache_Entry& entry) {
+		Cache_Entry written = entry;
+		written.modified = file_modified(file_name);
+		std::lock_guard<std::mutex> lock(mutex);
+		entries[file_name] = written;
+	}
+
+private:
+	/* the last write time of a file in nanoseconds since 1970, or 0 if it does not exist */
+	static int64_t file_modified(const std::string& file_name) {
+		std::error_code error;
+		const auto modified = std::filesystem::last_write_time(file_name, error);
+		if (error) {
+			return 0;
+		}
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::file_clock::to_sys(modified).time_since_epoch()
+		).count();
+	}
+
+	static bool file_matches(const std::string& file_name, const Cache_Entry& entry) {
+		std::error_code error;
+		uintmax_t size = std::filesystem::file_size(file_name, error);
+		return !error && size == entry.file_size && file_modified(file_name) == entry.modified;
+	}
+
+	std::string manifest_name;
+	bool force = false;
+	std::map<std::string, Cache_Entry> entries;
+	mutable std::mutex mutex;
+};
+
+/*
+** Writes a file through write_file_contents, unless the cache already has
+** a file with identical contents. Bytes [skip_begin, skip_end) (such as a
+** timestamp) are excluded from the content hash.
+*/
+template<typename Fill>
+Write_Status write_cached_file(
+	Table_Cache* cache, const std::string& file_name, uint64_t key,
+	const std::string& timestamp, size_t size, size_t skip_begin, size_t skip_end,
+	Fill fill
+) {
+	uint64_t content = 0;
+	Write_Status status = write_file_contents(file_name, size, [&](char* dst) {
+		fill(dst);
+		content = hash_bytes(dst, skip_begin);
+		content = hash_bytes(dst + skip_end, size - skip_end, content);
+		return cache == nullptr || !cache->has_content(file_name, content);
+	});
+	if (cache == nullptr) {
+		return status;
+	}
+	if (status == Write_Status::unchanged) {
+		Cache_Entry entry;
+		cache->find(file_name, entry);
+		entry.key = key;
+		cache->update(file_name, entry);
+	} else if (status == Write_Status::written) {
+		cache->update(file_name, {key, content, size, timestamp});
+	}
+	return status;
+}
+
+inline void print_write_status(Write_Status status, const std::string& file_name) {
+	switch (status) {
+		case Write_Status::written:
+			printf("Wrote file \"%s\"\n", file_name.c_str());
+			break;
+		case Write_Status::unchanged:
+			printf("Unchanged file \"%s\"\n", file_name.c_str());
+			break;
+		case Write_Status::failed:
+			break;
+	}
+}
+
+#endif /* TABLE_CACHE_HPP */
@@ -0,0 +1,264 @@
+#ifndef TABLE_COLUMNS_HPP
+#define TABLE_COLUMNS_HPP
+
+#include <algorithm>
+#include <bit>
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+/* floating point fields are stored as their raw bit patterns */
+enum class Field_Kind : uint8_t {
+	f32,
+	f64,
+	u32,
+	i32,
+	u64,
+	i64,
+	/* int, exported in decimal */
+	int_dec,
+	/* ilogb/frexp exponent, exported in decimal or by name */
+	expon,
+};
+
+/* 32bit kinds are stored as uint32_t, and 64bit kinds as uint64_t */
+constexpr bool field_is_wide(Field_Kind kind) {
+	switch (kind) {
+		case Field_Kind::f64:
+		case Field_Kind::u64:
+		case Field_Kind::i64:
+		case Field_Kind::expon:
+			return true;
+		default:
+			return false;
+	}
+}
+
+/* size of the C type of a field, which is also its alignment */
+constexpr size_t field_size(Field_Kind kind) {
+	switch (kind) {
+		case Field_Kind::f64:
+		case Field_Kind::u64:
+		case Field_Kind::i64:
+			return 8;
+		default:
+			return 4;
+	}
+}
+
+inline const char* field_c_type(Field_Kind kind) {
+	switch (kind) {
+		case Field_Kind::f32: return "uint32_t";
+		case Field_Kind::f64: return "uint64_t";
+		case Field_Kind::u32: return "uint32_t";
+		case Field_Kind::i32: return "int32_t";
+		case Field_Kind::u64: return "uint64_t";
+		case Field_Kind::i64: return "int64_t";
+		case Field_Kind::int_dec: return "int";
+		case Field_Kind::expon: return "int";
+	}
+	return "";
+}
+
+/*
+** The exponents of zero, infinity, and NaN are exported as FP_ILOGB0,
+** INT_MAX, and FP_ILOGBNAN. The sentinels lie outside the range of int.
+*/
+enum : int64_t {
+	expon_int_max = INT64_MIN,
+	expon_ilogbnan,
+	expon_ilogb0,
+};
+
+template<typename T>
+inline int64_t classify_expon(T x, int expon) {
+	switch (std::fpclassify(x)) {
+		case FP_INFINITE: return expon_int_max;
+		case FP_NAN: return expon_ilogbnan;
+		case FP_ZERO: return expon_ilogb0;
+		default: return expon;
+	}
+}
+
+template<typename T>
+using float_bits = std::conditional_t<sizeof(T) == sizeof(uint32_t), uint32_t, uint64_t>;
+
+template<typename T>
+constexpr Field_Kind float_kind = (sizeof(T) == sizeof(uint32_t)) ? Field_Kind::f32 : Field_Kind::f64;
+
+template<typename T>
+inline float_bits<T> to_bits(T x) {
+	return std::bit_cast<float_bits<T>>(x);
+}
+
+template<typename T>
+inline T from_bits(float_bits<T> x) {
+	return std::bit_cast<T>(x);
+}
+
+struct Field {
+	Field_Kind kind;
+	/* nullptr for the single field of a scalar record */
+	const char* name = nullptr;
+};
+
+struct Record_Layout {
+	std::vector<Field> fields;
+
+	Record_Layout(std::initializer_list<Field> field_list) : fields(field_list) {}
+
+	size_t size() const {
+		return fields.size();
+	}
+
+	bool is_scalar() const {
+		return fields.size() == 1 && fields[0].name == nullptr;
+	}
+
+	/* offset of a field within the C struct of the record */
+	size_t field_offset(size_t index) const {
+		size_t offset = 0;
+		for (size_t i = 0; i < index; i++) {
+			offset += field_size(fields[i].kind);
+			offset = (offset + field_size(fields[i + 1].kind) - 1) & ~(field_size(fields[i + 1].kind) - 1);
+		}
+		return offset;
+	}
+
+	/* sizeof the C struct of the record */
+	size_t record_size() const {
+		size_t align = 1;
+		for (const Field& field : fields) {
+			align = std::max(align, field_size(field.kind));
+		}
+		size_t size = field_offset(fields.size() - 1) + field_size(fields.back().kind);
+		return (size + align - 1) & ~(align - 1);
+	}
+
+	/* struct { uint32_t frac; int expon; } */
+	std::string c_type() const {
+		if (is_scalar()) {
+			return field_c_type(fields[0].kind);
+		}
+		std::string ret = "struct { ";
+		for (const Field& field : fields) {
+			ret += field_c_type(field.kind);
+			ret += " ";
+			ret += field.name;
+			ret += "; ";
+		}
+		ret += "}";
+		return ret;
+	}
+};
+
+/* one field of every record in a table */
+struct Column {
+	Field field;
+	std::variant<std::vector<uint32_t>, std::vector<uint64_t>> data;
+
+	Column(Field column_field, size_t count) : field(column_field) {
+		if (field_is_wide(field.kind)) {
+			data = std::vector<uint64_t>(count);
+		} else {
+			data = std::vector<uint32_t>(count);
+		}
+	}
+
+	template<typename U>
+	std::span<U> values() {
+		return std::get<std::vector<U>>(data);
+	}
+
+	template<typename U>
+	std::span<const U> values() const {
+		return std::get<std::vector<U>>(data);
+	}
+
+	uint64_t raw(size_t i) const {
+		if (field_is_wide(field.kind)) {
+			return std::get<std::vector<uint64_t>>(data)[i];
+		}
+		return std::get<std::vector<uint32_t>>(data)[i];
+	}
+};
+
+/* the input or output records of a table, stored column-wise */
+struct Record_Columns {
+	std::vector<Column> columns;
+	size_t count = 0;
+
+	Record_Columns() = default;
+
+	Record_Columns(const Record_Layout& layout, size_t record_count) : count(record_count) {
+		columns.reserve(layout.size());
+		for (const Field& field : layout.fields) {
+			columns.emplace_back(field, record_count);
+		}
+	}
+
+	size_t size() const {
+		return count;
+	}
+
+	Column& operator[](size_t i) {
+		return columns[i];
+	}
+
+	const Column& operator[](size_t i) const {
+		return columns[i];
+	}
+};
+
+/*
+** count records of the fields of columns [first_column, last_column). Used
+** as scratch by evaluators that must not take the columns of a table,
+** which other slices are evaluated into concurrently.
+*/
+inline Record_Columns scratch_records(
+	const Record_Columns& records, size_t first_column, size_t last_column, size_t count
+) {
+	Record_Columns scratch;
+	scratch.count = count;
+	scratch.columns.reserve(last_column - first_column);
+	for (size_t c = first_column; c < last_column; c++) {
+		scratch.columns.emplace_back(records[c].field, count);
+	}
+	return scratch;
+}
+
+/* a copy of records [begin, end), as records [0, end - begin) */
+inline Record_Columns copy_records(const Record_Columns& records, size_t begin, size_t end) {
+	Record_Columns copy = scratch_records(records, 0, records.columns.size(), end - begin);
+	for (size_t c = 0; c < records.columns.size(); c++) {
+		std::visit([&](auto& dst) {
+			const auto& src = std::get<std::decay_t<decltype(dst)>>(records[c].data);
+			std::copy(
+				src.begin() + static_cast<ptrdiff_t>(begin),
+				src.begin() + static_cast<ptrdiff_t>(end), dst.begin()
+			);
+		}, copy[c].data);
+	}
+	return copy;
+}
+
+/* copies every record of rows into records from record begin, into the columns from first_column */
+inline void store_records(
+	const Record_Columns& rows, Record_Columns& records, size_t first_column, size_t begin
+) {
+	for (size_t c = 0; c < rows.columns.size(); c++) {
+		std::visit([&](auto& dst) {
+			const auto& src = std::get<std::decay_t<decltype(dst)>>(rows[c].data);
+			std::copy(src.begin(), src.end(), dst.begin() + static_cast<ptrdiff_t>(begin));
+		}, records[first_column + c].data);
+	}
+}
+
+#endif /* TABLE_COLUMNS_HPP */
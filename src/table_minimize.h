@@ -0,0 +1,300 @@
+#ifndef TABLE_MINIMIZE_H
+#define TABLE_MINIMIZE_H
+
+#include <algorithm>
+#include <bit>
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <queue>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "edge_cases.h"
+#include "table_columns.hpp"
+
+/*
+** Coverage-driven minimization: a large pool of candidate rows is reduced
+** to a small subset that covers every feature the pool covers. A feature
+** is a property of one field of a row, such as "input 0 is a negative
+** subnormal" or "output 1 is FP_ILOGBNAN". Features of floats are:
+**   class     zero, subnormal, normal, infinite or NaN, with the sign
+**   band      one of 32 exponent bands of a normal value, with the sign
+**   tie       (inputs) integral, exactly halfway, within 1 ulp of halfway,
+**             other fraction, or too large to have a fraction
+**   overflow  (inputs, of tables with integer outputs) below, just below,
+**             just inside, inside, at, or above the range of int32_t,
+**             uint32_t, int64_t and uint64_t
+** Integers are classified by sign and bit width, and exponents by
+** sentinel, sign and magnitude.
+*/
+
+enum Feature_Category : uint32_t {
+	feature_class,
+	feature_band,
+	feature_tie,
+	feature_overflow,
+	feature_integer,
+	feature_expon,
+};
+
+/* field (input fields first, at most 16), category, and value */
+inline uint32_t feature_id(uint32_t field, Feature_Category category, uint32_t value) {
+	return (field << 16) | (static_cast<uint32_t>(category) << 12) | value;
+}
+
+constexpr uint32_t feature_exponent_bands = 32;
+
+/* where x lies relative to [low, high), where both bounds are exact in T */
+template<typename T>
+inline uint32_t overflow_region(T x, T low, T high) {
+	if (x < low) {
+		return (nextup(x) >= low) ? 1 : 0;
+	}
+	if (x >= high) {
+		return (nextdown(x) < high) ? 4 : 5;
+	}
+	return (nextdown(x) < low || nextup(x) >= high) ? 2 : 3;
+}
+
+template<typename T>
+inline void float_features(
+	float_bits<T> bits, uint32_t field, bool is_input, bool integer_output,
+	std::vector<uint32_t>& features
+) {
+	const T x = from_bits<T>(bits);
+	const uint32_t sign = std::signbit(x) ? 1 : 0;
+	const int fp_class = std::fpclassify(x);
+	uint32_t class_index;
+	switch (fp_class) {
+		case FP_ZERO: class_index = 0; break;
+		case FP_SUBNORMAL: class_index = 1; break;
+		case FP_NORMAL: class_index = 2; break;
+		case FP_INFINITE: class_index = 3; break;
+		default: class_index = 4; break;
+	}
+	features.push_back(feature_id(field, feature_class, class_index * 2 + sign));
+	if (fp_class == FP_NORMAL) {
+		constexpr int mant_bits = std::numeric_limits<T>::digits - 1;
+		constexpr uint64_t max_biased = 2 * std::numeric_limits<T>::max_exponent - 2;
+		const uint64_t biased = (static_cast<uint64_t>(bits) >> mant_bits) &
+			((uint64_t(1) << (sizeof(T) * CHAR_BIT - 1 - mant_bits)) - 1);
+		const uint32_t band = static_cast<uint32_t>(
+			(biased - 1) * feature_exponent_bands / max_biased
+		);
+		features.push_back(feature_id(field, feature_band, sign * feature_exponent_bands + band));
+	}
+	if (!is_input || !std::isfinite(x)) {
+		return;
+	}
+
+	const T magnitude = std::fabs(x);
+	uint32_t tie;
+	if (magnitude >= std::ldexp(static_cast<T>(1.0), std::numeric_limits<T>::digits - 1)) {
+		tie = 0;
+	} else {
+		const T fraction = magnitude - std::floor(magnitude);
+		const T half = static_cast<T>(0.5);
+		if (fraction == 0) {
+			tie = 1;
+		} else if (fraction == half) {
+			tie = 2;
+		} else if (nextdown(fraction) <= half && nextup(fraction) >= half) {
+			tie = 3;
+		} else {
+			tie = 4;
+		}
+	}
+	features.push_back(feature_id(field, feature_tie, sign * 8 + tie));
+
+	if (!integer_output) {
+		return;
+	}
+	const T two = static_cast<T>(2.0);
+	const T bounds[4][2] = {
+		{-std::ldexp(two, 30), std::ldexp(two, 30)},
+		{static_cast<T>(0.0), std::ldexp(two, 31)},
+		{-std::ldexp(two, 62), std::ldexp(two, 62)},
+		{static_cast<T>(0.0), std::ldexp(two, 63)},
+	};
+	for (uint32_t type = 0; type < 4; type++) {
+		const uint32_t region = overflow_region(x, bounds[type][0], bounds[type][1]);
+		features.push_back(feature_id(field, feature_overflow, type * 8 + region));
+	}
+}
+
+inline void integer_features(
+	const Field& field_info, uint64_t raw, uint32_t field, std::vector<uint32_t>& features
+) {
+	int64_t value;
+	switch (field_info.kind) {
+		case Field_Kind::i32:
+		case Field_Kind::int_dec:
+			value = static_cast<int32_t>(raw);
+			break;
+		case Field_Kind::i64:
+			value = static_cast<int64_t>(raw);
+			break;
+		default:
+			/* unsigned values are classified by bit width alone */
+			features.push_back(feature_id(
+				field, feature_integer, static_cast<uint32_t>(std::bit_width(raw))
+			));
+			return;
+	}
+	const uint32_t negative = (value < 0) ? 1 : 0;
+	const uint64_t magnitude =
+		negative ? (0 - static_cast<uint64_t>(value)) : static_cast<uint64_t>(value);
+	features.push_back(feature_id(
+		field, feature_integer, negative * 72 + static_cast<uint32_t>(std::bit_width(magnitude))
+	));
+}
+
+inline void expon_features(uint64_t raw, uint32_t field, std::vector<uint32_t>& features) {
+	const int64_t value = static_cast<int64_t>(raw);
+	uint32_t bucket;
+	if (value == expon_int_max) {
+		bucket = 0;
+	} else if (value == expon_ilogbnan) {
+		bucket = 1;
+	} else if (value == expon_ilogb0) {
+		bucket = 2;
+	} else {
+		const uint64_t magnitude = static_cast<uint64_t>(std::abs(value));
+		const uint32_t sign = (value < 0) ? 1 : 0;
+		bucket = 3 + sign * 16 + static_cast<uint32_t>(std::bit_width(magnitude));
+	}
+	features.push_back(feature_id(field, feature_expon, bucket));
+}
+
+/* features of row i, appended to features */
+inline void row_features(
+	const Record_Columns& input, const Record_Columns& output, size_t i,
+	bool integer_output, std::vector<uint32_t>& features
+) {
+	uint32_t field = 0;
+	for (const Record_Columns* records : {&input, &output}) {
+		const bool is_input = (records == &input);
+		for (const Column& column : records->columns) {
+			const uint64_t raw = column.raw(i);
+			switch (column.field.kind) {
+				case Field_Kind::f32:
+					float_features<float>(
+						static_cast<uint32_t>(raw), field, is_input, integer_output, features
+					);
+					break;
+				case Field_Kind::f64:
+					float_features<double>(raw, field, is_input, integer_output, features);
+					break;
+				case Field_Kind::expon:
+					expon_features(raw, field, features);
+					break;
+				default:
+					integer_features(column.field, raw, field, features);
+					break;
+			}
+			field++;
+		}
+	}
+}
+
+/* rows in ascending order, copied into new columns */
+inline Record_Columns select_rows(const Record_Columns& records, const std::vector<size_t>& rows) {
+	Record_Columns selected;
+	selected.count = rows.size();
+	selected.columns.reserve(records.columns.size());
+	for (const Column& column : records.columns) {
+		Column& dst = selected.columns.emplace_back(column.field, rows.size());
+		std::visit([&](auto& values) {
+			const auto& src = std::get<std::decay_t<decltype(values)>>(column.data);
+			for (size_t r = 0; r < rows.size(); r++) {
+				values[r] = src[rows[r]];
+			}
+		}, dst.data);
+	}
+	return selected;
+}
+
+struct Minimized_Rows {
+	std::vector<size_t> rows;
+	size_t feature_count;
+};
+
+/*
+** Greedy set cover: repeatedly takes the row covering the most features
+** that are not yet covered, preferring earlier rows (edge cases) on ties.
+** Gains only decrease, so a row whose recomputed gain is still the best in
+** the queue can be taken without recomputing the others.
+*/
+inline Minimized_Rows minimize_rows(const Record_Columns& input, const Record_Columns& output) {
+	bool integer_output = false;
+	for (const Column& column : output.columns) {
+		switch (column.field.kind) {
+			case Field_Kind::u32:
+			case Field_Kind::i32:
+			case Field_Kind::u64:
+			case Field_Kind::i64:
+				integer_output = true;
+				break;
+			default:
+				break;
+		}
+	}
+
+	const size_t count = input.size();
+	std::vector<uint32_t> features;
+	std::vector<size_t> offsets(count + 1);
+	for (size_t i = 0; i < count; i++) {
+		offsets[i] = features.size();
+		row_features(input, output, i, integer_output, features);
+		std::sort(features.begin() + static_cast<ptrdiff_t>(offsets[i]), features.end());
+		features.erase(
+			std::unique(features.begin() + static_cast<ptrdiff_t>(offsets[i]), features.end()),
+			features.end()
+		);
+	}
+	offsets[count] = features.size();
+
+	std::vector<bool> covered(size_t(1) << 20, false);
+	auto gain = [&](size_t row) {
+		uint32_t new_features = 0;
+		for (size_t f = offsets[row]; f < offsets[row + 1]; f++) {
+			new_features += covered[features[f]] ? 0 : 1;
+		}
+		return new_features;
+	};
+
+	/* (gain, ~row), so that equal gains pop the lowest row first */
+	std::priority_queue<std::pair<uint32_t, size_t>> queue;
+	for (size_t i = 0; i < count; i++) {
+		queue.push({static_cast<uint32_t>(offsets[i + 1] - offsets[i]), ~i});
+	}
+	Minimized_Rows result = {{}, 0};
+	while (!queue.empty()) {
+		auto [old_gain, inverted_row] = queue.top();
+		queue.pop();
+		const size_t row = ~inverted_row;
+		const uint32_t current = gain(row);
+		if (current == 0) {
+			continue;
+		}
+		if (current < old_gain && !queue.empty() && queue.top() > std::pair(current, inverted_row)) {
+			queue.push({current, inverted_row});
+			continue;
+		}
+		for (size_t f = offsets[row]; f < offsets[row + 1]; f++) {
+			covered[features[f]] = true;
+		}
+		result.feature_count += current;
+		result.rows.push_back(row);
+	}
+	std::sort(result.rows.begin(), result.rows.end());
+	return result;
+}
+
+#endif /* TABLE_MINIMIZE_H */
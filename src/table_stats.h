@@ -0,0 +1,341 @@
+#ifndef TABLE_STATS_H
+#define TABLE_STATS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "correct_round.h"
+
+/*
+** Per table telemetry for --stats, to tell whether a slow run is spent in
+** the RNG (input), libm (evaluate) or I/O (export).
+*/
+
+enum Stats_Stage : size_t {
+	stats_input,
+	stats_evaluate,
+	stats_check,
+	stats_export,
+	stats_stage_count
+};
+
+constexpr std::array<const char*, stats_stage_count> stats_stage_names = {
+	"input", "evaluate", "check", "export"
+};
+
+struct Perf_Sample {
+	uint64_t cycles = 0;
+	uint64_t instructions = 0;
+	uint64_t cache_misses = 0;
+};
+
+/*
+** Hardware counters of the calling thread, in user space only, so that
+** they can be opened without root with perf_event_paranoid <= 2.
+** Either every counter opens, or none are used.
+*/
+class Perf_Counters {
+public:
+	Perf_Counters() {
+#ifdef __linux__
+		constexpr std::array<uint64_t, 3> events = {
+			PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES
+		};
+		for (size_t i = 0; i < events.size(); i++) {
+			perf_event_attr attr = {};
+			attr.type = PERF_TYPE_HARDWARE;
+			attr.size = sizeof(attr);
+			attr.config = events[i];
+			attr.read_format = PERF_FORMAT_GROUP;
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			fds[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, fds[0], 0));
+			if (fds[i] < 0) {
+				close_all();
+				return;
+			}
+		}
+#endif
+	}
+
+	~Perf_Counters() {
+		close_all();
+	}
+
+	Perf_Counters(const Perf_Counters&) = delete;
+	Perf_Counters& operator=(const Perf_Counters&) = delete;
+
+	bool available() const {
+		return fds[0] >= 0;
+	}
+
+	bool read(Perf_Sample& sample) const {
+#ifdef __linux__
+		if (!available()) {
+			return false;
+		}
+		/* count, then one value per counter */
+		uint64_t values[4];
+		if (::read(fds[0], values, sizeof(values)) != static_cast<ssize_t>(sizeof(values))) {
+			return false;
+		}
+		sample = {values[1], values[2], values[3]};
+		return true;
+#else
+		(void)sample;
+		return false;
+#endif
+	}
+
+private:
+	void close_all() {
+#ifdef __linux__
+		for (int& fd : fds) {
+			if (fd >= 0) {
+				close(fd);
+			}
+			fd = -1;
+		}
+#endif
+	}
+
+	std::array<int, 3> fds = {-1, -1, -1};
+};
+
+inline Perf_Counters& thread_perf_counters() {
+	thread_local Perf_Counters counters;
+	return counters;
+}
+
+/* @returns the peak resident set size of the process so far, in bytes */
+inline uint64_t peak_rss_bytes() {
+#ifdef __linux__
+	rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) == 0) {
+		/* kilobytes on Linux */
+		return static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+	}
+#endif
+	return 0;
+}
+
+struct Stage_Stats {
+	std::atomic<uint64_t> nanoseconds = 0;
+	std::atomic<uint64_t> cycles = 0;
+	std::atomic<uint64_t> instructions = 0;
+	std::atomic<uint64_t> cache_misses = 0;
+	/* set once any perf sample was recorded for this stage */
+	std::atomic<bool> has_perf = false;
+};
+
+/* stages of one table may be recorded concurrently from several jobs */
+struct Table_Stats {
+	std::string type;
+	std::string table;
+	size_t rows;
+	std::atomic<uint64_t> bytes = 0;
+	/* rows of correctly rounded tables evaluated in a wider format, or left ambiguous */
+	std::atomic<uint64_t> oracle_escalations = 0;
+	std::atomic<uint64_t> oracle_unresolved = 0;
+	std::atomic<uint64_t> peak_rss = 0;
+	std::array<Stage_Stats, stats_stage_count> stages;
+
+	Table_Stats(const char* type_name, const std::string& table_name, size_t row_count) :
+		type(type_name), table(table_name), rows(row_count)
+	{}
+};
+
+/* a deque, so that pointers held by jobs stay valid as tables are added */
+using Stats_List = std::deque<Table_Stats>;
+
+/*
+** Adds the time, hardware counters and oracle escalations of its scope to
+** a stage. Does nothing if stats is null.
+*/
+class Stage_Timer {
+public:
+	Stage_Timer(Table_Stats* table_stats, Stats_Stage stats_stage) :
+		stats(table_stats), stage(stats_stage)
+	{
+		if (stats == nullptr) {
+			return;
+		}
+		escalations = oracle_escalations;
+		unresolved = oracle_unresolved;
+		has_perf = thread_perf_counters().read(perf);
+		start = std::chrono::steady_clock::now();
+	}
+
+	~Stage_Timer() {
+		if (stats == nullptr) {
+			return;
+		}
+		const auto elapsed = std::chrono::steady_clock::now() - start;
+		Stage_Stats& result = stats->stages[stage];
+		result.nanoseconds += static_cast<uint64_t>(
+			std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()
+		);
+		stats->oracle_escalations += oracle_escalations - escalations;
+		stats->oracle_unresolved += oracle_unresolved - unresolved;
+		Perf_Sample end;
+		if (has_perf && thread_perf_counters().read(end)) {
+			result.cycles += end.cycles - perf.cycles;
+			result.instructions += end.instructions - perf.instructions;
+			result.cache_misses += end.cache_misses - perf.cache_misses;
+			result.has_perf = true;
+		}
+	}
+
+	Stage_Timer(const Stage_Timer&) = delete;
+	Stage_Timer& operator=(const Stage_Timer&) = delete;
+
+private:
+	Table_Stats* stats;
+	Stats_Stage stage;
+	uint64_t escalations = 0;
+	uint64_t unresolved = 0;
+	bool has_perf = false;
+	Perf_Sample perf;
+	std::chrono::steady_clock::time_point start;
+};
+
+/* records the size of the files written for a table, and the peak RSS once it is done */
+inline void finish_table_stats(Table_Stats* stats, const std::vector<std::string>& files) {
+	if (stats == nullptr) {
+		return;
+	}
+	for (const std::string& file : files) {
+		std::error_code error;
+		uint64_t size = static_cast<uint64_t>(std::filesystem::file_size(file, error));
+		if (!error) {
+			stats->bytes += size;
+		}
+	}
+	stats->peak_rss = peak_rss_bytes();
+}
+
+inline double stage_seconds(const Stage_Stats& stage) {
+	return static_cast<double>(stage.nanoseconds) * 1.0e-9;
+}
+
+inline double elements_per_second(const Table_Stats& stats, const Stage_Stats& stage) {
+	return (stage.nanoseconds == 0) ? 0.0 : static_cast<double>(stats.rows) / stage_seconds(stage);
+}
+
+inline void print_stats(const Stats_List& list) {
+	printf(
+		"\n%-4s %-18s %10s %12s %10s %10s  %-8s %10s %10s %8s %8s\n",
+		"type", "table", "rows", "bytes", "escalated", "RSS MiB",
+		"stage", "ms", "Melem/s", "IPC", "miss/el"
+	);
+	for (const Table_Stats& stats : list) {
+		bool first = true;
+		for (size_t s = 0; s < stats_stage_count; s++) {
+			const Stage_Stats& stage = stats.stages[s];
+			if (stage.nanoseconds == 0) {
+				continue;
+			}
+			if (first) {
+				first = false;
+				printf(
+					"%-4s %-18s %10zu %12" PRIu64 " %10" PRIu64 " %10.1f  ",
+					stats.type.c_str(), stats.table.c_str(), stats.rows, stats.bytes.load(),
+					stats.oracle_escalations.load(),
+					static_cast<double>(stats.peak_rss) / 1048576.0
+				);
+			} else {
+				printf("%-4s %-18s %10s %12s %10s %10s  ", "", "", "", "", "", "");
+			}
+			printf(
+				"%-8s %10.3f %10.2f", stats_stage_names[s],
+				stage_seconds(stage) * 1.0e3, elements_per_second(stats, stage) * 1.0e-6
+			);
+			if (stage.has_perf && stage.cycles != 0) {
+				printf(
+					" %8.2f %8.3f\n",
+					static_cast<double>(stage.instructions) / static_cast<double>(stage.cycles),
+					static_cast<double>(stage.cache_misses) / static_cast<double>(stats.rows)
+				);
+			} else {
+				printf(" %8s %8s\n", "-", "-");
+			}
+		}
+	}
+	for (const Table_Stats& stats : list) {
+		if (stats.oracle_unresolved != 0) {
+			printf(
+				"Warning: %" PRIu64 " rows of %s %s may not be correctly rounded\n",
+				stats.oracle_unresolved.load(), stats.type.c_str(), stats.table.c_str()
+			);
+		}
+	}
+	printf("Peak RSS: %.1f MiB\n", static_cast<double>(peak_rss_bytes()) / 1048576.0);
+	if (!thread_perf_counters().available()) {
+		printf("Hardware counters unavailable (see /proc/sys/kernel/perf_event_paranoid)\n");
+	}
+}
+
+inline bool write_stats_json(const char* file_name, const Stats_List& list) {
+	FILE* file = fopen(file_name, "wb");
+	if (file == nullptr) {
+		printf("Unable to open file \"%s\"\n", file_name);
+		return false;
+	}
+	fprintf(file, "{\n\"peak_rss_bytes\": %" PRIu64 ",\n\"tables\": [\n", peak_rss_bytes());
+	size_t index = 0;
+	for (const Table_Stats& stats : list) {
+		fprintf(
+			file,
+			"{\"type\": \"%s\", \"table\": \"%s\", \"rows\": %zu, \"bytes\": %" PRIu64 ", "
+			"\"oracle_escalations\": %" PRIu64 ", "
+			"\"oracle_unresolved\": %" PRIu64 ", \"peak_rss_bytes\": %" PRIu64 ", \"stages\": {",
+			stats.type.c_str(), stats.table.c_str(), stats.rows, stats.bytes.load(),
+			stats.oracle_escalations.load(), stats.oracle_unresolved.load(),
+			stats.peak_rss.load()
+		);
+		const char* separator = "";
+		for (size_t s = 0; s < stats_stage_count; s++) {
+			const Stage_Stats& stage = stats.stages[s];
+			if (stage.nanoseconds == 0) {
+				continue;
+			}
+			fprintf(
+				file, "%s\"%s\": {\"seconds\": %.9g, \"elements_per_second\": %.6g",
+				separator, stats_stage_names[s], stage_seconds(stage),
+				elements_per_second(stats, stage)
+			);
+			if (stage.has_perf) {
+				fprintf(
+					file,
+					", \"cycles\": %" PRIu64 ", \"instructions\": %" PRIu64 ", "
+					"\"cache_misses\": %" PRIu64,
+					stage.cycles.load(), stage.instructions.load(), stage.cache_misses.load()
+				);
+			}
+			fprintf(file, "}");
+			separator = ", ";
+		}
+		index++;
+		fprintf(file, "}}%s\n", (index < list.size()) ? "," : "");
+	}
+	fprintf(file, "]\n}\n");
+	return fclose(file) == 0;
+}
+
+#endif /* TABLE_STATS_H */
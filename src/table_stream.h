@@ -0,0 +1,204 @@
+#ifndef TABLE_STREAM_H
+#define TABLE_STREAM_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bounded_queue.hpp"
+#include "table_cache.hpp"
+#include "table_columns.hpp"
+#include "table_stats.h"
+#include "table_writer.h"
+#include "test_gen.hpp"
+
+/* the fixed text of a header table, around the input and output records */
+struct Table_Text {
+	std::string head;
+	/* the timestamp line of head, which is excluded from the content hash */
+	size_t timestamp_begin;
+	size_t timestamp_end;
+	std::string input_head;
+	std::string output_head;
+	std::string array_tail;
+	std::string tail;
+};
+
+/* rows per chunk, and chunks buffered between two stages */
+constexpr size_t stream_chunk_rows = 65536;
+constexpr size_t stream_queue_chunks = 4;
+
+struct Stream_Chunk {
+	/* false for input records, true for output records */
+	bool output;
+	size_t first_row;
+	Record_Columns records;
+};
+
+struct Text_Chunk {
+	std::vector<char> text;
+	/* bytes [skip_begin, skip_end) are not hashed */
+	size_t skip_begin = 0;
+	size_t skip_end = 0;
+};
+
+inline Text_Chunk make_text_chunk(const std::string& text) {
+	Text_Chunk chunk;
+	chunk.text.assign(text.begin(), text.end());
+	return chunk;
+}
+
+/*
+** Writes a header table of any number of rows in constant memory, as a
+** pipeline of three threads connected by bounded queues:
+**   generate: input chunks, then regenerated input chunks with their outputs
+**   format:   records to text
+**   write:    text to a temporary file, hashing it for the cache
+** The output array follows the whole input array in the file, so the
+** inputs are generated twice rather than held until the outputs are
+** written. This relies on generators only depending on the seed and the
+** row index. If check_failed is set, outputs are checked against the
+** scalar reference, and a mismatch sets it and discards the file. Stages
+** are timed into stats if it is not null.
+*/
+template<typename T>
+Write_Status stream_table(
+	const Test_Gen<T>& table, const std::string& file_name, size_t rows, uint64_t seed,
+	const Table_Text& text, const std::string& timestamp, Table_Cache* cache, uint64_t key,
+	std::atomic<bool>* check_failed = nullptr, Table_Stats* stats = nullptr
+) {
+	std::atomic<bool> mismatch = false;
+	Bounded_Queue<Stream_Chunk> records(stream_queue_chunks);
+	Bounded_Queue<Text_Chunk> texts(stream_queue_chunks);
+
+	std::thread generator([&] {
+		for (bool output : {false, true}) {
+			for (size_t first = 0; first < rows; first += stream_chunk_rows) {
+				const size_t count = std::min(stream_chunk_rows, rows - first);
+				Gen_Slice slice = {seed, rows, first, 0, count};
+				Record_Columns input(table.input_layout, count);
+				{
+					Stage_Timer timer(stats, stats_input);
+					table.generate_input(slice, input);
+				}
+				if (!output) {
+					if (!records.push({false, first, std::move(input)})) {
+						return;
+					}
+					continue;
+				}
+				Record_Columns result(table.output_layout, count);
+				{
+					Stage_Timer timer(stats, stats_evaluate);
+					table.evaluate(input, result, 0, count);
+				}
+				bool matches = true;
+				if (check_failed != nullptr) {
+					Stage_Timer timer(stats, stats_check);
+					matches = table.matches_reference(input, result, 0, count);
+				}
+				if (!matches) {
+					mismatch = true;
+					*check_failed = true;
+					records.close();
+					return;
+				}
+				if (!records.push({true, first, std::move(result)})) {
+					return;
+				}
+			}
+		}
+		records.close();
+	});
+
+	std::thread formatter([&] {
+		Text_Chunk head = make_text_chunk(text.head + text.input_head);
+		head.skip_begin = text.timestamp_begin;
+		head.skip_end = text.timestamp_end;
+		bool ok = texts.push(std::move(head));
+		bool in_output = false;
+		Stream_Chunk chunk;
+		while (ok && records.pop(chunk)) {
+			if (chunk.output && !in_output) {
+				ok = texts.push(make_text_chunk(text.array_tail + text.output_head));
+				in_output = true;
+			}
+			Text_Chunk formatted;
+			{
+				Stage_Timer timer(stats, stats_export);
+				formatted.text.resize(records_text_length(chunk.records, chunk.first_row));
+				write_records_text(formatted.text.data(), chunk.records, chunk.first_row);
+			}
+			ok = ok && texts.push(std::move(formatted));
+		}
+		if (ok && !in_output) {
+			ok = texts.push(make_text_chunk(text.array_tail + text.output_head));
+		}
+		if (ok) {
+			texts.push(make_text_chunk(text.array_tail + text.tail));
+		}
+		records.close();
+		texts.close();
+	});
+
+	const std::string temp_name = temporary_file_name(file_name);
+	FILE* file = fopen(temp_name.c_str(), "wb");
+	bool ok = (file != nullptr);
+	if (!ok) {
+		printf("Unable to open file \"%s\"\n", temp_name.c_str());
+		texts.close();
+	}
+	uint64_t content = 0;
+	uint64_t size = 0;
+	Text_Chunk chunk;
+	while (ok && texts.pop(chunk)) {
+		Stage_Timer timer(stats, stats_export);
+		if (fwrite(chunk.text.data(), 1, chunk.text.size(), file) != chunk.text.size()) {
+			printf("Unable to write file \"%s\"\n", temp_name.c_str());
+			ok = false;
+			texts.close();
+			break;
+		}
+		if (chunk.skip_end != 0) {
+			content = hash_bytes(chunk.text.data(), chunk.skip_begin, content);
+		}
+		content = hash_bytes(
+			chunk.text.data() + chunk.skip_end, chunk.text.size() - chunk.skip_end, content
+		);
+		size += chunk.text.size();
+	}
+	formatter.join();
+	generator.join();
+	if (file != nullptr && fclose(file) != 0) {
+		ok = false;
+	}
+	if (!ok || mismatch) {
+		remove(temp_name.c_str());
+		return Write_Status::failed;
+	}
+
+	if (cache != nullptr && cache->has_content(file_name, content)) {
+		remove(temp_name.c_str());
+		Cache_Entry entry;
+		cache->find(file_name, entry);
+		entry.key = key;
+		cache->update(file_name, entry);
+		return Write_Status::unchanged;
+	}
+	if (!replace_file(temp_name, file_name)) {
+		printf("Unable to replace file \"%s\"\n", file_name.c_str());
+		remove(temp_name.c_str());
+		return Write_Status::failed;
+	}
+	if (cache != nullptr) {
+		cache->update(file_name, {key, content, size, timestamp});
+	}
+	return Write_Status::written;
+}
+
+#endif /* TABLE_STREAM_H */
@@ -0,0 +1,248 @@
+#ifndef TABLE_WRITER_H
+#define TABLE_WRITER_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/* posix_fallocate reserves the mapped file, which macOS lacks */
+#if defined(__unix__)
+	#define TABLE_WRITER_MMAP 1
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <unistd.h>
+#else
+	#define TABLE_WRITER_MMAP 0
+#endif
+
+#include "export_value.h"
+#include "hex_encode.h"
+#include "table_columns.hpp"
+
+/*
+** Each row of a table is an index comment padded to 4 digits, followed by
+** the record as a single field or as `{field, field, ...}`, and `,\n`.
+*/
+
+inline size_t decimal_length(size_t value) {
+	size_t len = 1;
+	while (value >= 10) {
+		value /= 10;
+		len++;
+	}
+	return len;
+}
+
+inline size_t row_index_length(size_t index) {
+	return sizeof("/* ") - 1 + std::max<size_t>(decimal_length(index), 4) + sizeof(" */ ") - 1;
+}
+
+inline char* write_row_index(char* dst, size_t index) {
+	size_t digits = decimal_length(index);
+	size_t width = std::max<size_t>(digits, 4);
+	std::memcpy(dst, "/* ", 3);
+	dst += 3;
+	std::memset(dst, ' ', width - digits);
+	for (size_t i = width; i-- > width - digits;) {
+		dst[i] = static_cast<char>('0' + index % 10);
+		index /= 10;
+	}
+	dst += width;
+	std::memcpy(dst, " */ ", 4);
+	return dst + 4;
+}
+
+inline bool records_are_scalar(const Record_Columns& records) {
+	return records.columns.size() == 1 && records[0].field.name == nullptr;
+}
+
+inline size_t records_text_length(const Record_Columns& records, size_t index_base = 0) {
+	size_t record_frame = records_are_scalar(records) ? 0 : 2 + 2 * (records.columns.size() - 1);
+	size_t total = 0;
+	for (size_t i = 0; i < records.size(); i++) {
+		total += row_index_length(index_base + i) + record_frame + 2;
+	}
+	for (const Column& column : records.columns) {
+		const char* macro = field_literal_macro(column.field.kind);
+		if (macro != nullptr) {
+			total += records.size() * hex_literal_length(macro, field_hex_digits(column.field.kind));
+			continue;
+		}
+		for (size_t i = 0; i < records.size(); i++) {
+			total += decimal_field_length(column, i);
+		}
+	}
+	return total;
+}
+
+/*
+** Writes exactly records_text_length(records, index_base) bytes.
+** Hex columns are batch encoded a block of rows at a time, then the rows
+** are assembled from the encoded blocks.
+** @returns a pointer past the end of the text
+*/
+inline char* write_records_text(char* dst, const Record_Columns& records, size_t index_base = 0) {
+	constexpr size_t block_rows = 256;
+	const bool scalar = records_are_scalar(records);
+	const size_t column_count = records.columns.size();
+
+	std::vector<size_t> literal_len(column_count, 0);
+	std::vector<std::vector<char>> block_text(column_count);
+	for (size_t c = 0; c < column_count; c++) {
+		const char* macro = field_literal_macro(records[c].field.kind);
+		if (macro != nullptr) {
+			literal_len[c] = hex_literal_length(macro, field_hex_digits(records[c].field.kind));
+			block_text[c].resize(block_rows * literal_len[c]);
+		}
+	}
+
+	for (size_t begin = 0; begin < records.size(); begin += block_rows) {
+		size_t count = std::min(block_rows, records.size() - begin);
+		for (size_t c = 0; c < column_count; c++) {
+			const Column& column = records[c];
+			const char* macro = field_literal_macro(column.field.kind);
+			if (macro == nullptr) {
+				continue;
+			}
+			if (field_is_wide(column.field.kind)) {
+				encode_hex_literals(
+					column.values<uint64_t>().subspan(begin, count),
+					macro, block_text[c].data(), literal_len[c]
+				);
+			} else {
+				encode_hex_literals(
+					column.values<uint32_t>().subspan(begin, count),
+					macro, block_text[c].data(), literal_len[c]
+				);
+			}
+		}
+		for (size_t r = 0; r < count; r++) {
+			size_t i = begin + r;
+			dst = write_row_index(dst, index_base + i);
+			if (!scalar) {
+				*dst++ = '{';
+			}
+			for (size_t c = 0; c < column_count; c++) {
+				if (c != 0) {
+					*dst++ = ',';
+					*dst++ = ' ';
+				}
+				if (literal_len[c] != 0) {
+					std::memcpy(dst, &block_text[c][r * literal_len[c]], literal_len[c]);
+					dst += literal_len[c];
+				} else {
+					dst = write_decimal_field(dst, records[c], i);
+				}
+			}
+			if (!scalar) {
+				*dst++ = '}';
+			}
+			*dst++ = ',';
+			*dst++ = '\n';
+		}
+	}
+	return dst;
+}
+
+/* a unique name next to file_name, so concurrent writers never share a file */
+inline std::string temporary_file_name(const std::string& file_name) {
+	static std::atomic<uint64_t> counter{0};
+	return file_name + ".tmp" + std::to_string(counter.fetch_add(1));
+}
+
+inline bool replace_file(const std::string& from, const std::string& to) {
+	#if !TABLE_WRITER_MMAP
+		/* rename does not replace an existing file on every platform */
+		remove(to.c_str());
+	#endif
+	return rename(from.c_str(), to.c_str()) == 0;
+}
+
+enum class Write_Status {
+	written,
+	/* fill() chose to keep the existing file */
+	unchanged,
+	failed,
+};
+
+/*
+** Creates a file of exactly `size` bytes and fills it in place with
+** fill(char* dst), which returns false to discard the new contents and
+** keep the existing file. The file is allocated and memory mapped where
+** available, otherwise it is filled in one buffer and written with a
+** single fwrite.
+** The contents go to a temporary file which then replaces file_name,
+** so readers and concurrent writers never see a partially written file.
+*/
+template<typename Fill>
+Write_Status write_file_contents(const std::string& file_name, size_t size, Fill fill) {
+	std::string temp_name = temporary_file_name(file_name);
+	bool keep = true;
+	#if TABLE_WRITER_MMAP
+		int fd = open(temp_name.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+		if (fd < 0) {
+			printf("Unable to open file \"%s\"\n", temp_name.c_str());
+			return Write_Status::failed;
+		}
+		if (size != 0) {
+			/*
+			** Stores through the mapping cannot report a full disk, other
+			** than by SIGBUS, so every block of the file is allocated first
+			*/
+			int error = posix_fallocate(fd, 0, static_cast<off_t>(size));
+			if (error != 0) {
+				printf(
+					"Unable to allocate %zu bytes for file \"%s\": %s\n",
+					size, temp_name.c_str(), strerror(error)
+				);
+				close(fd);
+				remove(temp_name.c_str());
+				return Write_Status::failed;
+			}
+			void* map = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+			if (map == MAP_FAILED) {
+				printf("Unable to map file \"%s\"\n", temp_name.c_str());
+				close(fd);
+				remove(temp_name.c_str());
+				return Write_Status::failed;
+			}
+			keep = fill(static_cast<char*>(map));
+			munmap(map, size);
+		}
+		close(fd);
+	#else
+		std::vector<char> buf(size);
+		keep = fill(buf.data());
+		if (keep) {
+			FILE* file = fopen(temp_name.c_str(), "wb");
+			if (file == nullptr) {
+				printf("Unable to open file \"%s\"\n", temp_name.c_str());
+				return Write_Status::failed;
+			}
+			size_t written = fwrite(buf.data(), 1, buf.size(), file);
+			fclose(file);
+			if (written != buf.size()) {
+				printf("Unable to write file \"%s\"\n", temp_name.c_str());
+				remove(temp_name.c_str());
+				return Write_Status::failed;
+			}
+		}
+	#endif
+	if (!keep) {
+		remove(temp_name.c_str());
+		return Write_Status::unchanged;
+	}
+	if (!replace_file(temp_name, file_name)) {
+		printf("Unable to replace file \"%s\"\n", file_name.c_str());
+		remove(temp_name.c_str());
+		return Write_Status::failed;
+	}
+	return Write_Status::written;
+}
+
+#endif /* TABLE_WRITER_H */
@@ -1,40 +1,167 @@
 #ifndef TEST_GEN_HPP
 #define TEST_GEN_HPP
 
-#include <vector>
 #include <string>
-#include <functional>
+#include <cinttypes>
 #include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "table_columns.hpp"
+
+/* bump when a generator changes its output, to invalidate cached tables */
+constexpr uint32_t test_gen_version = 4;
+
+/*
+** Rows [begin, end) of a set of columns, where element 0 of the columns is
+** row index_base of a table with table_rows rows. Generators only depend
+** on the seed and the row index, so any slice can be generated on its own.
+*/
+struct Gen_Slice {
+	uint64_t seed;
+	size_t table_rows;
+	size_t index_base;
+	size_t begin;
+	size_t end;
+
+	size_t row(size_t i) const {
+		return index_base + i;
+	}
+};
+
+/*
+** Rows evaluated by each table of a fused pass before moving on to the next
+** table, small enough for the shared inputs to stay in the L1 cache.
+*/
+constexpr size_t fuse_block_rows = 1024;
+
+/* twins of a table, evaluated in every rounding mode or recording exception flags */
+enum class Table_Variant : uint8_t {
+	none,
+	modes,
+	flags,
+};
+
+/*
+** Drivers are standalone C programs that run a routine under test over
+** the rows of a header table, compare its results bitwise against the
+** outputs, and time it. Each table lists the calls its driver makes:
+** statements over locals named after the fields (x and result for scalar
+** records), where ROUTINE is replaced by a macro that the user can define
+** to the routine under test. For example, frexp is
+**   {"ROUTINE", "frexpf", "frac = ROUTINE(x, &expon);"}
+** Macros without a default must be defined when compiling the driver.
+*/
+struct Driver_Call {
+	/* <PREFIX>_<macro> */
+	std::string macro;
+	/* what the macro is defined to by default, or empty */
+	std::string default_routine;
+	std::string statement;
+};
+
+/* fills rows [begin, end) of the input columns */
+using Generate_Function = void (*)(const Gen_Slice&, Record_Columns&);
+
+/* computes rows [begin, end) of the output columns from the input columns */
+using Evaluate_Function = void (*)(const Record_Columns&, Record_Columns&, size_t, size_t);
 
+/*
+** A table is described by its layouts and by plain function pointers to
+** template instances, so that the per element work of every slice is
+** compiled into a single loop, and only the call per slice is indirect.
+** The C types, sizes and binary layouts of the records are derived from
+** the layouts.
+*/
 template<typename T>
 struct Test_Gen {
-	std::function<
-		void (std::vector<std::string>&, std::vector<std::string>&)
-	> generate;
+	Generate_Function generate_input;
+	Evaluate_Function evaluate;
+
+	/*
+	** the scalar evaluator that evaluate is batched from, if any, which must
+	** produce bitwise identical outputs
+	*/
+	Evaluate_Function reference;
 
 	std::string table_name;
-	std::string input_type;
-	std::string output_type;
+	Record_Layout input_layout;
+	Record_Layout output_layout;
 	std::string headers;
-	size_t element_size;
+	/* combinations of edge cases leading the table, which --edge-product makes room for */
+	size_t edge_rows = 0;
+	/* calls made by the generated C driver. Tables without calls have no driver */
+	std::vector<Driver_Call> driver_calls;
+	/* results are correctly rounded, rather than exact */
+	bool correctly_rounded = false;
+	/* the _modes or _flags twin of a base table, only generated with --modes or --flags */
+	Table_Variant variant = Table_Variant::none;
 
 	Test_Gen(
-		std::function<
-			void (std::vector<std::string>&, std::vector<std::string>&)
-		> generate_function,
-		const char* table_name,
-		const char* input_type,
-		const char* output_type,
-		const char* headers,
-		size_t element_size
+		Generate_Function generate_input_function,
+		Evaluate_Function evaluate_function,
+		const char* name,
+		Record_Layout input,
+		Record_Layout output,
+		const char* header_list,
+		Evaluate_Function reference_function = nullptr
 	) :
-		generate(generate_function),
-		table_name(table_name),
-		input_type(input_type),
-		output_type(output_type),
-		headers(headers),
-		element_size(element_size)
+		generate_input(generate_input_function),
+		evaluate(evaluate_function),
+		reference(reference_function),
+		table_name(name),
+		input_layout(input),
+		output_layout(output),
+		headers(header_list)
 	{}
+
+	/* size of an input record and an output record in C */
+	size_t element_size() const {
+		return input_layout.record_size() + output_layout.record_size();
+	}
+
+	void generate(const Gen_Slice& slice, Record_Columns& input, Record_Columns& output) const {
+		generate_input(slice, input);
+		evaluate(input, output, slice.begin, slice.end);
+	}
+
+	/*
+	** Compares rows [begin, end) of output against the reference evaluator,
+	** printing the first mismatches. @returns false on any bitwise mismatch
+	*/
+	bool matches_reference(
+		const Record_Columns& input, const Record_Columns& output, size_t begin, size_t end
+	) const {
+		if (reference == nullptr) {
+			return true;
+		}
+		Record_Columns expected(output_layout, output.size());
+		reference(input, expected, begin, end);
+		size_t mismatches = 0;
+		for (size_t i = begin; i < end; i++) {
+			for (size_t c = 0; c < output.columns.size(); c++) {
+				if (output[c].raw(i) == expected[c].raw(i)) {
+					continue;
+				}
+				if (mismatches++ < 8) {
+					printf(
+						"Error: %s row %zu input 0x%" PRIX64 " column %zu: batched 0x%" PRIX64
+						" != scalar 0x%" PRIX64 "\n",
+						table_name.c_str(), i, input[0].raw(i), c,
+						output[c].raw(i), expected[c].raw(i)
+					);
+				}
+			}
+		}
+		if (mismatches != 0) {
+			printf(
+				"Error: %s has %zu mismatches against scalar evaluation\n",
+				table_name.c_str(), mismatches
+			);
+		}
+		return mismatches == 0;
+	}
 };
 
 #endif /* TEST_GEN_HPP */
@@ -0,0 +1,1542 @@
+#ifndef TEST_LIST_H
+#define TEST_LIST_H
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <limits>
+#include <span>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "binary_export.h"
+#include "correct_round.h"
+#include "delta_encode.h"
+#include "driver_export.h"
+#include "edge_cases.h"
+#include "edge_product.h"
+#include "exception_flags.h"
+#include "options.h"
+#include "random_gen.h"
+#include "rounding_modes.h"
+#include "stratified_sampler.h"
+#include "table_cache.hpp"
+#include "table_columns.hpp"
+#include "table_stream.h"
+#include "table_writer.h"
+#include "test_gen.hpp"
+#include "vector_kernels.h"
+
+/*
+** The generators, evaluators, and exporters of every table, shared by the
+** generator and the benchmarks.
+*/
+
+template<typename T>
+struct float_name;
+
+template<>
+struct float_name<float> {
+	static constexpr const char* fX = "f32";
+	static constexpr const char* fpX = "fp32";
+	static constexpr const char* abi_type = "float";
+	/* names the libm functions of the type in drivers, by default with an f suffix */
+	static constexpr const char* libm_macro = "TEST_GEN_F32_LIBM";
+	static constexpr const char* int_type = "uint32_t";
+	static constexpr const char* int_literal = "UINT32_C";
+	static constexpr size_t type_bits = 32;
+};
+
+template<>
+struct float_name<double> {
+	static constexpr const char* fX = "f64";
+	static constexpr const char* fpX = "fp64";
+	static constexpr const char* abi_type = "long double";
+	static constexpr const char* libm_macro = "TEST_GEN_F64_LIBM";
+	static constexpr const char* int_type = "uint64_t";
+	static constexpr const char* int_literal = "UINT64_C";
+	static constexpr size_t type_bits = 64;
+};
+
+/* edge_cases<T> followed by random finite values, stratified by sign and exponent */
+template <typename T>
+inline void generate_unary_input(const Gen_Slice& slice, Record_Columns& input) {
+	auto x = input[0].values<float_bits<T>>();
+	const Random_Stream rng = {slice.seed, stream_value};
+	size_t i = slice.begin;
+	for (; i < slice.end && slice.row(i) < edge_cases<T>.size(); i++) {
+		x[i] = to_bits(edge_cases<T>[slice.row(i)]);
+	}
+	random_gen_stratified<T>(x.subspan(i, slice.end - i), rng, slice.row(i));
+}
+
+template <typename T>
+inline void evaluate_ilogb_test(
+	const Record_Columns& input,
+	Record_Columns& output,
+	size_t begin, size_t end
+) {
+	auto x = input[0].values<float_bits<T>>();
+	auto expon = output[0].values<uint64_t>();
+	for (size_t i = begin; i < end; i++) {
+		T value = from_bits<T>(x[i]);
+		int result = std::ilogb(value);
+		expon[i] = static_cast<uint64_t>(classify_expon(value, result));
+	}
+}
+
+template <typename T>
+inline void evaluate_logb_test(
+	const Record_Columns& input,
+	Record_Columns& output,
+	size_t begin, size_t end
+) {
+	auto x = input[0].values<float_bits<T>>();
+	auto y = output[0].values<float_bits<T>>();
+	for (size_t i = begin; i < end; i++) {
+		y[i] = to_bits(std::logb(from_bits<T>(x[i])));
+	}
+}
+
+template <typename T>
+inline void evaluate_frexp_test(
+	const Record_Columns& input,
+	Record_Columns& output,
+	size_t begin, size_t end
+) {
+	auto x = input[0].values<float_bits<T>>();
+	auto frac = output[0].values<float_bits<T>>();
+	auto expon = output[1].values<uint64_t>();
+	for (size_t i = begin; i < end; i++) {
+		T value = from_bits<T>(x[i]);
+		int result_expon;
+		T result = std::frexp(value, &result_expon);
+		frac[i] = to_bits(result);
+		expon[i] = static_cast<uint64_t>(classify_expon(value, result_expon));
+	}
+}
+
+template <typename T>
+struct ldexp_params {
+	static constexpr int rand_expon_range
+	= std::numeric_limits<T>::max_exponent
+	- std::numeric_limits<T>::min_exponent
+	+ std::numeric_limits<T>::digits;
+
+	static constexpr std::array<int, 13> expon_edge_cases = {
+		0, 1, -1, 2, -2,
+		std::numeric_limits<T>::digits,
+		std::numeric_limits<T>::max_exponent,
+		rand_expon_range,
+		rand_expon_range - 1,
+		-std::numeric_limits<T>::digits,
+		-std::numeric_limits<T>::max_exponent,
+		-rand_expon_range,
+		-rand_expon_range + 1,
+	};
+};
+
+/* edge_cases<T> by ldexp_params<T>::expon_edge_cases */
+template <typename T>
+inline Edge_Product<2> ldexp_edge_product() {
+	return Edge_Product<2>({edge_cases<T>.size(), ldexp_params<T>::expon_edge_cases.size()});
+}
+
+template <typename T>
+inline void generate_ldexp_input(const Gen_Slice& slice, Record_Columns& input) {
+	using params = ldexp_params<T>;
+	const Edge_Product<2> product = ldexp_edge_product<T>();
+	auto x = input[0].values<float_bits<T>>();
+	auto n = input[1].values<uint32_t>();
+	const Random_Stream value_rng = {slice.seed, stream_value};
+	const Random_Stream expon_rng = {slice.seed, stream_expon};
+	const Stratified_Sampler<T>& sampler = finite_sampler<T>();
+	for (size_t i = slice.begin; i < slice.end; i++) {
+		size_t row = slice.row(i);
+		const size_t combination = product.combination_of(row, slice.table_rows);
+		int expon;
+		if (combination < product.size()) {
+			const std::array<size_t, 2> indices = product.indices(combination);
+			x[i] = to_bits(edge_cases<T>[indices[0]]);
+			expon = params::expon_edge_cases[indices[1]];
+		} else {
+			x[i] = sampler.sample(value_rng, row);
+			expon = static_cast<int>(random_int(
+				expon_rng, row, -params::rand_expon_range, params::rand_expon_range
+			));
+			if (row % 16 != 0) {
+				expon /= std::numeric_limits<T>::max_exponent / 64;
+			}
+		}
+		n[i] = static_cast<uint32_t>(expon);
+	}
+}
+
+template <typename T>
+inline void evaluate_ldexp_test(
+	const Record_Columns& input,
+	Record_Columns& output,
+	size_t begin, size_t end
+) {
+	auto x = input[0].values<float_bits<T>>();
+	auto n = input[1].values<uint32_t>();
+	auto y = output[0].values<float_bits<T>>();
+	for (size_t i = begin; i < end; i++) {
+		y[i] = to_bits(std::ldexp(from_bits<T>(x[i]), static_cast<int>(n[i])));
+	}
+}
+
+template <typename T>
+inline const std::array<T, 14> nextafter_target_edge_cases = {
+	static_cast<T>(0.0),
+	std::numeric_limits<T>::denorm_min(),
+	static_cast<T>(1.0),
+	std::numeric_limits<T>::max(),
+	std::numeric_limits<T>::infinity(),
+	std::numeric_limits<T>::quiet_NaN(),
+	std::numeric_limits<T>::signaling_NaN(),
+	-static_cast<T>(0.0),
+	-std::numeric_limits<T>::denorm_min(),
+	-static_cast<T>(1.0),
+	-std::numeric_limits<T>::max(),
+	-std::numeric_limits<T>::infinity(),
+	-std::numeric_limits<T>::quiet_NaN(),
+	-std::numeric_limits<T>::signaling_NaN(),
+};
+
+/* edge_cases<T> by nextafter_target_edge_cases<T> */
+template <typename T>
+inline std::array<std::span<const T>, 2> nextafter_edge_sets() {
+	return {edge_cases<T>, nextafter_target_edge_cases<T>};
+}
+
+template <typename T>
+inline void generate_nextafter_input(const Gen_Slice& slice, Record_Columns& input) {
+	const Stratified_Sampler<T>& sampler = finite_sampler<T>();
+	generate_product_input<T, 2>(
+		slice, input, nextafter_edge_sets<T>(), {stream_value, stream_target}, {&sampler, &sampler}
+	);
+}
+
+template <typename T>
+inline void evaluate_nextafter_test(
+	const Record_Columns& input,
+	Record_Columns& output,
+	size_t begin, size_t end
+) {
+	auto x = input[0].values<float_bits<T>>();
+	auto t = input[1].values<float_bits<T>>();
+	auto y = output[0].values<float_bits<T>>();
+	for (size_t i = begin; i < end; i++) {
+		y[i] = to_bits(ieee_nextafter(from_bits<T>(x[i]), from_bits<T>(t[i])));
+	}
+}
+
+/* every combination of edge_cases<T>, 64000 rows */
+template <typename T>
+inline std::array<std::span<const T>, 3> fma_edge_sets() {
+	return {edge_cases<T>, edge_cases<T>, edge_cases<T>};
+}
+
+template <typename T>
+inline void generate_fma_input(const Gen_Slice& slice, Record_Columns& input) {
+	const Stratified_Sampler<T>& sampler = finite_sampler<T>();
+	generate_product_input<T, 3>(
+		slice, input, fma_edge_sets<T>(), {stream_x, stream_y, stream_z},
+		{&sampler, &sampler, &sampler}
+	);
+}
+
+template <typename T>
+inline void evaluate_fma_test(
+	const Record_Columns& input,
+	Record_Columns& output,
+	size_t begin, size_t end
+) {
+	auto x = input[0].values<float_bits<T>>();
+	auto y = input[1].values<float_bits<T>>();
+	auto z = input[2].values<float_bits<T>>();
+	auto result = output[0].values<float_bits<T>>();
+	for (size_t i = begin; i < end; i++) {
+		result[i] = to_bits(std::fma(from_bits<T>(x[i]), from_bits<T>(y[i]), from_bits<T>(z[i])));
+	}
+}
+
+/* edge_cases<T> by edge_cases<T>, 1600 rows */
+template <typename T>
+inline std::array<std::span<const T>, 2> binary_edge_sets() {
+	return {edge_cases<T>, edge_cases<T>};
+}
+
+template <typename T>
+inline void generate_binary_input(const Gen_Slice& slice, Record_Columns& input) {
+	const Stratified_Sampler<T>& sampler = finite_sampler<T>();
+	generate_product_input<T, 2>(
+		slice, input, binary_edge_sets<T>(), {stream_x, stream_y}, {&sampler, &sampler}
+	);
+}
+
+/*
+** Random rows of pow have positive bases and exponents of magnitude at
+** most max_exponent, since most other finite inputs overflow or underflow
+*/
+template <typename T>
+inline void generate_pow_input(const Gen_Slice& slice, Record_Columns& input) {
+	constexpr T max_expon = static_cast<T>(std::numeric_limits<T>::max_exponent);
+	static const Stratified_Sampler<T> base_sampler(value_ranges<T>(
+		std::numeric_limits<T>::denorm_min(), std::numeric_limits<T>::max()
+	));
+	static const Stratified_Sampler<T> expon_sampler(value_ranges<T>(-max_expon, max_expon));
+	generate_product_input<T, 2>(
+		slice, input, binary_edge_sets<T>(), {stream_x, stream_y},
+		{&base_sampler, &expon_sampler}
+	);
+}
+
+/* result = function(x, y) */
+template <typename T, typename Function>
+inline void evaluate_binary(
+	const Record_Columns& input,
+	Record_Columns& output,
+	size_t begin, size_t end,
+	Function function
+) {
+	auto x = input[0].values<float_bits<T>>();
+	auto y = input[1].values<float_bits<T>>();
+	auto result = output[0].values<float_bits<T>>();
+	for (size_t i = begin; i < end; i++) {
+		result[i] = to_bits(function(from_bits<T>(x[i]), from_bits<T>(y[i])));
+	}
+}
+
+template <typename T>
+inline void evaluate_fmod_test(
+	const Record_Columns& input,
+	Record_Columns& output,
+	size_t begin, size_t end
+) {
+	evaluate_binary<T>(input, output, begin, end, [](T x, T y) { return std::fmod(x, y); });
+}
+
+template <typename T>
+inline void evaluate_remainder_test(
+	const Record_Columns& input,
+	Record_Columns& output,
+	size_t begin, size_t end
+) {
+	evaluate_binary<T>(input, output, begin, end, [](T x, T y) { return std::remainder(x, y); });
+}
+
+template <typename T>
+inline void evaluate_copysign_test(
+	const Record_Columns& input,
+	Record_Columns& output,
+	size_t begin, size_t end
+) {
+	evaluate_binary<T>(input, output, begin, end, [](T x, T y) { return std::copysign(x, y); });
+}
+
+/* quo only has its sign and 3 low bits specified, and is 0 if rem is NaN */
+template <typename T>
+inline void evaluate_remquo_test(
+	const Record_Columns& input,
+	Record_Columns& output,
+	size_t begin, size_t end
+) {
+	auto x = input[0].values<float_bits<T>>();
+	auto y = input[1].values<float_bits<T>>();
+	auto rem = output[0].values<float_bits<T>>();
+	auto quo = output[1].values<uint32_t>();
+	for (size_t i = begin; i < end; i++) {
+		int result_quo;
+		T result = std::remquo(from_bits<T>(x[i]), from_bits<T>(y[i]), &result_quo);
+		if (std::isnan(result)) {
+			result_quo = 0;
+		} else {
+			result_quo = (result_quo < 0) ? -(-result_quo & 7) : (result_quo & 7);
+		}
+		rem[i] = to_bits(result);
+		quo[i] = static_cast<uint32_t>(result_quo);
+	}
+}
+
+template <typename T>
+inline void evaluate_fmin_fmax_test(
+	const Record_Columns& input,
+	Record_Columns& output,
+	size_t begin, size_t end
+) {
+	auto x = input[0].values<float_bits<T>>();
+	auto y = input[1].values<float_bits<T>>();
+	auto r_fmin = output[0].values<float_bits<T>>();
+	auto r_fmax = output[1].values<float_bits<T>>();
+	for (size_t i = begin; i < end; i++) {
+		r_fmin[i] = to_bits(std::fmin(from_bits<T>(x[i]), from_bits<T>(y[i])));
+		r_fmax[i] = to_bits(std::fmax(from_bits<T>(x[i]), from_bits<T>(y[i])));
+		/*
+		** C leaves which zero fmin and fmax return for -0 and +0 unspecified,
+		** so the tables order -0 below +0, as IEEE 754 minimumNumber does
+		*/
+		if (from_bits<T>(x[i]) == 0 && from_bits<T>(y[i]) == 0) {
+			r_fmin[i] = x[i] | y[i];
+			r_fmax[i] = x[i] & y[i];
+		}
+	}
+}
+
+template <typename T>
+inline void evaluate_sqrt_test(
+	const Record_Columns& input,
+	Record_Columns& output,
+	size_t begin, size_t end
+) {
+	auto x = input[0].values<float_bits<T>>();
+	auto y = output[0].values<float_bits<T>>();
+	for (size_t i = begin; i < end; i++) {
+		y[i] = to_bits(std::sqrt(from_bits<T>(x[i])));
+	}
+}
+
+template <typename T>
+inline void evaluate_float_to_f32_test(
+	const Record_Columns& input,
+	Record_Columns& output,
+	size_t begin, size_t end
+) {
+	auto x = input[0].values<float_bits<T>>();
+	auto y = output[0].values<uint32_t>();
+	for (size_t i = begin; i < end; i++) {
+		y[i] = to_bits(static_cast<float>(from_bits<T>(x[i])));
+	}
+}
+
+template <typename T>
+inline void evaluate_float_to_f64_test(
+	const Record_Columns& input,
+	Record_Columns& output,
+	size_t begin, size_t end
+) {
+	auto x = input[0].values<float_bits<T>>();
+	auto y = output[0].values<uint64_t>();
+	for (size_t i = begin; i < end; i++) {
+		y[i] = to_bits(static_cast<double>(from_bits<T>(x[i])));
+	}
+}
+
+template <typename T>
+inline void evaluate_modf_test(
+	const Record_Columns& input,
+	Record_Columns& output,
+	size_t begin, size_t end
+) {
+	auto x = input[0].values<float_bits<T>>();
+	auto frac_part = output[0].values<float_bits<T>>();
+	auto trunc_part = output[1].values<float_bits<T>>();
+	for (size_t i = begin; i < end; i++) {
+		T integral_part;
+		T result = std::modf(from_bits<T>(x[i]), &integral_part);
+		frac_part[i] = to_bits(result);
+		trunc_part[i] = to_bits(integral_part);
+	}
+}
+
+template <typename T>
+inline void evaluate_rounding_test(
+	const Record_Columns& input,
+	Record_Columns& output,
+	size_t begin, size_t end
+) {
+	auto x = input[0].values<float_bits<T>>();
+	auto r_floor = output[0].values<float_bits<T>>();
+	auto r_ceil = output[1].values<float_bits<T>>();
+	auto r_round = output[2].values<float_bits<T>>();
+	for (size_t i = begin; i < end; i++) {
+		T value = from_bits<T>(x[i]);
+		r_floor[i] = to_bits(std::floor(value));
+		r_ceil[i] = to_bits(std::ceil(value));
+		r_round[i] = to_bits(std::round(value));
+	}
+}
+
+template <typename T>
+inline void generate_float_to_integer_input(const Gen_Slice& slice, Record_Columns& input) {
+	auto x = input[0].values<float_bits<T>>();
+	const Random_Stream rng = {slice.seed, stream_value};
+	#if 0
+		const std::array<T, 6> integer_edge_cases = {
+			static_cast<T>(UINT32_MAX),
+			static_cast<T>(INT32_MAX),
+			static_cast<T>(INT32_MIN),
+			static_cast<T>(UINT64_MAX),
+			static_cast<T>(INT64_MAX),
+			static_cast<T>(INT64_MIN),
+		};
+		const size_t edge_count = edge_cases<T>.size() + integer_edge_cases.size();
+		for (size_t i = slice.begin; i < slice.end; i++) {
+			size_t row = slice.row(i);
+			T value;
+			if (row < edge_cases<T>.size()) {
+				value = edge_cases<T>[row];
+			} else if (row < edge_count) {
+				value = integer_edge_cases[row - edge_cases<T>.size()];
+			} else {
+				switch (row % 4) {
+					case 0: value = random_real<T>(rng, row, -0x1.0p+1, +0x1.0p+1); break;
+					case 1: value = random_real<T>(rng, row, -0x1.0p+30, +0x1.0p+30); break;
+					case 2: value = random_real<T>(rng, row, -0x1.0p+60, +0x1.0p+60); break;
+					default: value = random_real<T>(rng, row, 0.0, 1.0); break;
+				}
+			}
+			x[i] = to_bits(value);
+		}
+	#else
+		const std::array<T, 12> integer_edge_cases = {
+			static_cast<T>(0.0),
+			static_cast<T>(0.5),
+			static_cast<T>(1.0),
+			static_cast<T>(1.5),
+			static_cast<T>(2.0),
+			static_cast<T>(2.5),
+			static_cast<T>(-0.0),
+			static_cast<T>(-0.5),
+			static_cast<T>(-1.0),
+			static_cast<T>(-1.5),
+			static_cast<T>(-2.0),
+			static_cast<T>(-2.5),
+		};
+		for (size_t i = slice.begin; i < slice.end; i++) {
+			size_t row = slice.row(i);
+			T value;
+			if (row < integer_edge_cases.size()) {
+				value = integer_edge_cases[row];
+			} else {
+				value = random_real<T>(
+					rng, row, static_cast<T>(-0x1.0p+30), static_cast<T>(+0x1.0p+30)
+				);
+			}
+			x[i] = to_bits(value);
+		}
+	#endif
+}
+
+template <typename T>
+inline void evaluate_float_to_integer_test(
+	const Record_Columns& input,
+	Record_Columns& output,
+	size_t begin, size_t end
+) {
+	auto x = input[0].values<float_bits<T>>();
+	auto u32 = output[0].values<uint32_t>();
+	auto i32 = output[1].values<uint32_t>();
+	auto u64 = output[2].values<uint64_t>();
+	auto i64 = output[3].values<uint64_t>();
+	for (size_t i = begin; i < end; i++) {
+		T value = from_bits<T>(x[i]);
+		u32[i] = (uint32_t)(value);
+		i32[i] = static_cast<uint32_t>((int32_t)(value));
+		u64[i] = (uint64_t)(value);
+		i64[i] = static_cast<uint64_t>((int64_t)(value));
+	}
+}
+
+template <typename T>
+inline void generate_float_from_integer_input(const Gen_Slice& slice, Record_Columns& input) {
+	const std::array<uint32_t, 5> u32_edge_cases = {
+		0,
+		1,
+		std::numeric_limits<uint32_t>::max(),
+		std::numeric_limits<int32_t>::max(),
+		static_cast<uint32_t>(std::numeric_limits<int32_t>::min()),
+	};
+	const std::array<uint64_t, 5> u64_edge_cases = {
+		0,
+		1,
+		std::numeric_limits<uint64_t>::max(),
+		std::numeric_limits<int64_t>::max(),
+		static_cast<uint64_t>(std::numeric_limits<int64_t>::min()),
+	};
+
+	auto u32 = input[0].values<uint32_t>();
+	auto u64 = input[1].values<uint64_t>();
+	const Random_Stream u32_rng = {slice.seed, stream_u32};
+	const Random_Stream u64_rng = {slice.seed, stream_u64};
+	for (size_t i = slice.begin; i < slice.end; i++) {
+		size_t row = slice.row(i);
+		if (row < u32_edge_cases.size()) {
+			u32[i] = u32_edge_cases[row];
+			u64[i] = u64_edge_cases[row];
+		} else {
+			u32[i] = static_cast<uint32_t>(u32_rng.bits(row));
+			u64[i] = u64_rng.bits(row);
+		}
+	}
+}
+
+template <typename T>
+inline void evaluate_float_from_integer_test(
+	const Record_Columns& input,
+	Record_Columns& output,
+	size_t begin, size_t end
+) {
+	auto u32 = input[0].values<uint32_t>();
+	auto u64 = input[1].values<uint64_t>();
+	auto fu32 = output[0].values<float_bits<T>>();
+	auto fi32 = output[1].values<float_bits<T>>();
+	auto fu64 = output[2].values<float_bits<T>>();
+	auto fi64 = output[3].values<float_bits<T>>();
+	for (size_t i = begin; i < end; i++) {
+		fu32[i] = to_bits(static_cast<T>(u32[i]));
+		fi32[i] = to_bits(static_cast<T>(static_cast<int32_t>(u32[i])));
+		fu64[i] = to_bits(static_cast<T>(u64[i]));
+		fi64[i] = to_bits(static_cast<T>(static_cast<int64_t>(u64[i])));
+	}
+}
+
+/*
+** Batched evaluators, which fall back to the scalar evaluators above for
+** whatever the AVX2 kernels leave over.
+*/
+
+template <typename T>
+inline void evaluate_sqrt_batched(
+	const Record_Columns& input,
+	Record_Columns& output,
+	size_t begin, size_t end
+) {
+	#ifdef __AVX2__
+		const float_bits<T>* x = input[0].values<float_bits<T>>().data();
+		float_bits<T>* y = output[0].values<float_bits<T>>().data();
+		evaluate_batched(begin, end, vector_lanes<T>,
+			[&](size_t i, size_t n) { return sqrt_avx2<T>(x + i, y + i, n); },
+			[&](size_t i, size_t next) { evaluate_sqrt_test<T>(input, output, i, next); }
+		);
+	#else
+		evaluate_sqrt_test<T>(input, output, begin, end);
+	#endif
+}
+
+template <typename T>
+inline void evaluate_float_to_f32_batched(
+	const Record_Columns& input,
+	Record_Columns& output,
+	size_t begin, size_t end
+) {
+	#ifdef __AVX2__
+		if constexpr (std::is_same_v<T, double>) {
+			const uint64_t* x = input[0].values<uint64_t>().data();
+			uint32_t* y = output[0].values<uint32_t>().data();
+			evaluate_batched(begin, end, vector_lanes<T>,
+				[&](size_t i, size_t n) { return f64_to_f32_avx2(x + i, y + i, n); },
+				[&](size_t i, size_t next) {
+					evaluate_float_to_f32_test<T>(input, output, i, next);
+				}
+			);
+			return;
+		}
+	#endif
+	evaluate_float_to_f32_test<T>(input, output, begin, end);
+}
+
+template <typename T>
+inline void evaluate_float_to_f64_batched(
+	const Record_Columns& input,
+	Record_Columns& output,
+	size_t begin, size_t end
+) {
+	#ifdef __AVX2__
+		if constexpr (std::is_same_v<T, float>) {
+			const uint32_t* x = input[0].values<uint32_t>().data();
+			uint64_t* y = output[0].values<uint64_t>().data();
+			evaluate_batched(begin, end, vector_lanes<T>,
+				[&](size_t i, size_t n) { return f32_to_f64_avx2(x + i, y + i, n); },
+				[&](size_t i, size_t next) {
+					evaluate_float_to_f64_test<T>(input, output, i, next);
+				}
+			);
+			return;
+		}
+	#endif
+	evaluate_float_to_f64_test<T>(input, output, begin, end);
+}
+
+template <typename T>
+inline void evaluate_modf_batched(
+	const Record_Columns& input,
+	Record_Columns& output,
+	size_t begin, size_t end
+) {
+	#ifdef __AVX2__
+		const float_bits<T>* x = input[0].values<float_bits<T>>().data();
+		float_bits<T>* frac_part = output[0].values<float_bits<T>>().data();
+		float_bits<T>* trunc_part = output[1].values<float_bits<T>>().data();
+		evaluate_batched(begin, end, vector_lanes<T>,
+			[&](size_t i, size_t n) {
+				return modf_avx2<T>(x + i, frac_part + i, trunc_part + i, n);
+			},
+			[&](size_t i, size_t next) { evaluate_modf_test<T>(input, output, i, next); }
+		);
+	#else
+		evaluate_modf_test<T>(input, output, begin, end);
+	#endif
+}
+
+template <typename T>
+inline void evaluate_rounding_batched(
+	const Record_Columns& input,
+	Record_Columns& output,
+	size_t begin, size_t end
+) {
+	#ifdef __AVX2__
+		const float_bits<T>* x = input[0].values<float_bits<T>>().data();
+		float_bits<T>* r_floor = output[0].values<float_bits<T>>().data();
+		float_bits<T>* r_ceil = output[1].values<float_bits<T>>().data();
+		float_bits<T>* r_round = output[2].values<float_bits<T>>().data();
+		evaluate_batched(begin, end, vector_lanes<T>,
+			[&](size_t i, size_t n) {
+				return rounding_avx2<T>(x + i, r_floor + i, r_ceil + i, r_round + i, n);
+			},
+			[&](size_t i, size_t next) { evaluate_rounding_test<T>(input, output, i, next); }
+		);
+	#else
+		evaluate_rounding_test<T>(input, output, begin, end);
+	#endif
+}
+
+template <typename T>
+inline void evaluate_float_to_integer_batched(
+	const Record_Columns& input,
+	Record_Columns& output,
+	size_t begin, size_t end
+) {
+	#ifdef __AVX2__
+		const float_bits<T>* x = input[0].values<float_bits<T>>().data();
+		uint32_t* u32 = output[0].values<uint32_t>().data();
+		uint32_t* i32 = output[1].values<uint32_t>().data();
+		uint64_t* u64 = output[2].values<uint64_t>().data();
+		uint64_t* i64 = output[3].values<uint64_t>().data();
+		evaluate_batched(begin, end, vector_lanes<T>,
+			[&](size_t i, size_t n) {
+				return to_integer_avx2<T>(x + i, u32 + i, i32 + i, u64 + i, i64 + i, n);
+			},
+			[&](size_t i, size_t next) {
+				evaluate_float_to_integer_test<T>(input, output, i, next);
+			}
+		);
+	#else
+		evaluate_float_to_integer_test<T>(input, output, begin, end);
+	#endif
+}
+
+template <typename T>
+inline void evaluate_float_from_integer_batched(
+	const Record_Columns& input,
+	Record_Columns& output,
+	size_t begin, size_t end
+) {
+	#ifdef __AVX2__
+		const uint32_t* u32 = input[0].values<uint32_t>().data();
+		const uint64_t* u64 = input[1].values<uint64_t>().data();
+		float_bits<T>* fu32 = output[0].values<float_bits<T>>().data();
+		float_bits<T>* fi32 = output[1].values<float_bits<T>>().data();
+		float_bits<T>* fu64 = output[2].values<float_bits<T>>().data();
+		float_bits<T>* fi64 = output[3].values<float_bits<T>>().data();
+		evaluate_batched(begin, end, vector_lanes<T>,
+			[&](size_t i, size_t n) {
+				return from_integer_avx2<T>(
+					u32 + i, u64 + i, fu32 + i, fi32 + i, fu64 + i, fi64 + i, n
+				);
+			},
+			[&](size_t i, size_t next) {
+				evaluate_float_from_integer_test<T>(input, output, i, next);
+			}
+		);
+	#else
+		evaluate_float_from_integer_test<T>(input, output, begin, end);
+	#endif
+}
+
+inline std::string get_ISO8601Timestamp() {
+	time_t now;
+	time(&now);
+	char buf[sizeof("2000-01-01T00:00:00Z")];
+	strftime(buf, sizeof(buf), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+	std::string ret = buf;
+	return ret;
+}
+
+template<typename T>
+std::string table_file_name(const Test_Gen<T>& table) {
+	std::string file_name = float_name<T>::fX;
+	file_name += "_";
+	file_name += table.table_name;
+	file_name += ".h";
+	return file_name;
+}
+
+template<typename T>
+std::string table_prefix(const Test_Gen<T>& table) {
+	return std::string(float_name<T>::fX) + "_" + table.table_name;
+}
+
+/* whether a --table name, such as ldexp, ldexp_LUT or f64_ldexp_LUT, names table_name */
+template<typename T>
+bool table_name_matches(const std::string& table_name, const std::string& name) {
+	return name == table_name || name + "_LUT" == table_name ||
+		name == std::string(float_name<T>::fX) + "_" + table_name;
+}
+
+template<typename T>
+bool table_matches(const Test_Gen<T>& table, const std::string& name) {
+	return table_name_matches<T>(table.table_name, name);
+}
+
+/* the name of the table a twin is made from, such as sqrt_LUT for sqrt_modes_LUT */
+template<typename T>
+std::string base_table_name(const Test_Gen<T>& table) {
+	std::string name = table.table_name;
+	if (table.variant != Table_Variant::none) {
+		/* _modes and _flags are both 6 characters, inserted before _LUT */
+		name.erase(name.size() - 10, 6);
+	}
+	return name;
+}
+
+/*
+** Twins are only generated when named, such as fma_flags, or with --modes or
+** --flags, for every selected base table
+*/
+template<typename T>
+bool table_selected(const Test_Gen<T>& table, const Gen_Options& options) {
+	const unsigned type = (float_name<T>::type_bits == 32) ? type_f32 : type_f64;
+	if ((options.types & type) == 0) {
+		return false;
+	}
+	const bool twin_enabled =
+		(table.variant == Table_Variant::none) ||
+		(table.variant == Table_Variant::modes && options.modes) ||
+		(table.variant == Table_Variant::flags && options.flags);
+	if (options.tables.empty()) {
+		return twin_enabled;
+	}
+	const std::string base_name = base_table_name(table);
+	return std::any_of(
+		options.tables.begin(), options.tables.end(),
+		[&](const std::string& name) {
+			return table_matches(table, name) ||
+				(twin_enabled && table_name_matches<T>(base_name, name));
+		}
+	);
+}
+
+/*
+** Tables whose inputs only depend on the seed and the row. The inputs of
+** each are a prefix of the inputs of any larger one, which --format shared
+** writes once per type.
+*/
+template<typename T>
+bool has_shared_input(const Test_Gen<T>& table) {
+	return table.generate_input == &generate_unary_input<T>;
+}
+
+/* --format shared writes tables without shared inputs as header tables */
+template<typename T>
+bool writes_header_table(const Test_Gen<T>& table, unsigned formats) {
+	return (formats & format_header) || ((formats & format_shared) && !has_shared_input(table));
+}
+
+template<typename T>
+bool writes_shared_table(const Test_Gen<T>& table, unsigned formats) {
+	return (formats & format_shared) && has_shared_input(table);
+}
+
+/* such as f32_unary_inputs */
+template<typename T>
+std::string shared_input_name() {
+	return std::string(float_name<T>::fX) + "_unary_inputs";
+}
+
+/* every file written for a table in the selected formats */
+template<typename T>
+std::vector<std::string> table_output_files(const Test_Gen<T>& table, unsigned formats) {
+	std::vector<std::string> files;
+	if (writes_header_table(table, formats)) {
+		files.push_back(table_file_name(table));
+	}
+	if (writes_shared_table(table, formats)) {
+		files.push_back(table_prefix(table) + "_shared.h");
+	}
+	if (formats & format_binary) {
+		files.push_back(table_prefix(table) + ".bin");
+		files.push_back(table_prefix(table) + "_bin.h");
+	}
+	if (formats & format_encoded) {
+		files.push_back(table_prefix(table) + "_enc.h");
+	}
+	return files;
+}
+
+template<typename T>
+size_t table_rows(const Test_Gen<T>& table, const Gen_Options& options) {
+	if (options.count != 0) {
+		return options.count;
+	}
+	if (options.minimize != 0) {
+		return options.minimize;
+	}
+	size_t elem_count = 32768 / table.element_size();
+	const size_t default_rows = std::min<size_t>(elem_count, 1024);
+	if (!options.edge_product) {
+		/* a table with more edge case combinations holds an evenly spread subset of them */
+		return default_rows;
+	}
+	/* random rows after the edge cases: half as many as edge cases, at most default_rows */
+	const size_t random_rows = std::min(table.edge_rows / 2, default_rows);
+	return std::max(default_rows, table.edge_rows + random_rows);
+}
+
+/* everything that determines the contents of a table */
+template<typename T>
+uint64_t table_key(const Test_Gen<T>& table, const Gen_Options& options) {
+	uint64_t key = hash_value(test_gen_version);
+	key = hash_string(float_name<T>::fX, key);
+	key = hash_string(table.table_name, key);
+	key = hash_string(table.input_layout.c_type(), key);
+	key = hash_string(table.output_layout.c_type(), key);
+	key = hash_string(table.headers, key);
+	key = hash_value(options.seed, key);
+	key = hash_value(static_cast<uint64_t>(table_rows(table, options)), key);
+	key = hash_value(static_cast<uint64_t>(options.minimize != 0), key);
+	return hash_value(libm_fingerprint(), key);
+}
+
+/* the include guard of a file, such as F32_SQRT_LUT_H for f32_sqrt_LUT.h */
+inline std::string include_guard(const std::string& file_name) {
+	std::string guard = file_name;
+	std::transform(guard.begin(), guard.end(), guard.begin(), ::toupper);
+	std::replace(guard.begin(), guard.end(), '.', '_');
+	return guard;
+}
+
+template<typename T>
+Table_Text table_text(const Test_Gen<T>& table, size_t rows, const std::string& timestamp) {
+	const std::string guard = include_guard(table_file_name(table));
+
+	Table_Text text;
+	text.head += "#ifndef " + guard + "\n";
+	text.head += "#define " + guard + "\n\n";
+	text.head += table.headers + "\n\n";
+	text.timestamp_begin = text.head.size();
+	text.head += "/* Generated " + timestamp + " */\n\n";
+	text.timestamp_end = text.head.size();
+	text.head += "typedef " + table.input_layout.c_type() + " input_type;\n\n";
+	text.head += "typedef " + table.output_layout.c_type() + " output_type;\n\n";
+
+	const std::string prefix = table_prefix(table);
+	text.input_head = "const input_type " + prefix + "_input[" + std::to_string(rows) + "] = {\n";
+	text.output_head = "const output_type " + prefix + "_output[" + std::to_string(rows) + "] = {\n";
+	text.array_tail = "};\n\n";
+	text.tail = "#endif /* " + guard + " */\n";
+	return text;
+}
+
+/*
+** The generation timestamp is excluded from the content hash, so a table
+** regenerated with identical contents leaves the existing file untouched.
+*/
+template<typename T>
+Write_Status write_header_table(
+	const Test_Gen<T>& table,
+	const std::string& file_name,
+	const Record_Columns& input,
+	const Record_Columns& output,
+	Table_Cache* cache,
+	uint64_t key
+) {
+	const std::string timestamp = get_ISO8601Timestamp();
+	const Table_Text text = table_text(table, input.size(), timestamp);
+
+	size_t file_size =
+		text.head.size() +
+		text.input_head.size() + records_text_length(input) + text.array_tail.size() +
+		text.output_head.size() + records_text_length(output) + text.array_tail.size() +
+		text.tail.size();
+
+	return write_cached_file(
+		cache, file_name, key, timestamp, file_size, text.timestamp_begin, text.timestamp_end,
+		[&](char* dst) {
+			auto append = [&](const std::string& str) {
+				std::memcpy(dst, str.data(), str.size());
+				dst += str.size();
+			};
+			append(text.head);
+			append(text.input_head);
+			dst = write_records_text(dst, input);
+			append(text.array_tail);
+			append(text.output_head);
+			dst = write_records_text(dst, output);
+			append(text.array_tail);
+			append(text.tail);
+		}
+	);
+}
+
+template<typename T>
+void export_table(
+	const Test_Gen<T>& table,
+	const Record_Columns& input,
+	const Record_Columns& output,
+	Table_Cache* cache,
+	uint64_t key
+) {
+	const std::string file_name = table_file_name(table);
+	print_write_status(write_header_table(table, file_name, input, output, cache, key), file_name);
+}
+
+/* rows of the shared inputs of a type, the most rows of any table sharing them */
+template<typename T>
+size_t shared_input_rows(const std::vector<Test_Gen<T>>& tests, const Gen_Options& options) {
+	size_t rows = 0;
+	for (const Test_Gen<T>& table : tests) {
+		if (has_shared_input(table)) {
+			rows = std::max(rows, table_rows(table, options));
+		}
+	}
+	return rows;
+}
+
+/* writes the first rows of generate_unary_input to f32_unary_inputs.h or f64_unary_inputs.h */
+template<typename T>
+void export_shared_inputs(size_t rows, uint64_t seed, Table_Cache* cache) {
+	const std::string name = shared_input_name<T>();
+	const std::string file_name = name + ".h";
+	uint64_t key = hash_value(test_gen_version);
+	key = hash_string(name, key);
+	key = hash_value(seed, key);
+	key = hash_value(static_cast<uint64_t>(rows), key);
+	if (cache != nullptr && cache->is_fresh(file_name, key)) {
+		printf("Up to date \"%s\"\n", file_name.c_str());
+		return;
+	}
+
+	std::string macro = name;
+	std::transform(macro.begin(), macro.end(), macro.begin(), ::toupper);
+	const std::string guard = include_guard(file_name);
+	const std::string timestamp = get_ISO8601Timestamp();
+	std::string head;
+	head += "#ifndef " + guard + "\n";
+	head += "#define " + guard + "\n\n";
+	head += "#include <stdint.h>\n\n";
+	const size_t timestamp_begin = head.size();
+	head += "/* Generated " + timestamp + " */\n\n";
+	const size_t timestamp_end = head.size();
+	head += "/* the inputs of the " + std::string(float_name<T>::fX) + " *_shared.h tables */\n\n";
+	head += "typedef " + std::string(float_name<T>::int_type) + " " + name + "_type;\n\n";
+	head += "#define " + macro + "_COUNT " + std::to_string(rows) + "\n";
+	head += "const " + name + "_type " + name + "[" + std::to_string(rows) + "] = {\n";
+	const std::string tail = "};\n\n#endif /* " + guard + " */\n";
+
+	Record_Columns input({{float_kind<T>}}, rows);
+	const Gen_Slice slice = {seed, rows, 0, 0, rows};
+	generate_unary_input<T>(slice, input);
+	const size_t file_size = head.size() + records_text_length(input) + tail.size();
+	Write_Status status = write_cached_file(
+		cache, file_name, key, timestamp, file_size, timestamp_begin, timestamp_end,
+		[&](char* dst) {
+			std::memcpy(dst, head.data(), head.size());
+			dst = write_records_text(dst + head.size(), input);
+			std::memcpy(dst, tail.data(), tail.size());
+		}
+	);
+	print_write_status(status, file_name);
+}
+
+/*
+** Writes the outputs of a table with shared inputs to <prefix>_shared.h,
+** row i being the output for element i of the shared inputs.
+*/
+template<typename T>
+void export_table_shared(
+	const Test_Gen<T>& table,
+	const Record_Columns& output,
+	Table_Cache* cache,
+	uint64_t key
+) {
+	const std::string prefix = table_prefix(table);
+	const std::string file_name = prefix + "_shared.h";
+	const std::string guard = include_guard(file_name);
+	const std::string inputs = shared_input_name<T>();
+	std::string inputs_macro = inputs;
+	std::transform(inputs_macro.begin(), inputs_macro.end(), inputs_macro.begin(), ::toupper);
+	const std::string rows = std::to_string(output.size());
+	const std::string timestamp = get_ISO8601Timestamp();
+
+	std::string head;
+	head += "#ifndef " + guard + "\n";
+	head += "#define " + guard + "\n\n";
+	head += table.headers + "\n";
+	head += "#include \"" + inputs + ".h\"\n\n";
+	const size_t timestamp_begin = head.size();
+	head += "/* Generated " + timestamp + " */\n\n";
+	const size_t timestamp_end = head.size();
+	head += "#if " + inputs_macro + "_COUNT < " + rows + "\n";
+	head += "#error \"" + file_name + " needs a larger " + inputs + ".h\"\n";
+	head += "#endif\n\n";
+	head += "typedef " + table.output_layout.c_type() + " " + prefix + "_output_type;\n\n";
+	head += "/* the outputs for the first " + rows + " elements of " + inputs + " */\n";
+	head += "const " + prefix + "_output_type " + prefix + "_output[" + rows + "] = {\n";
+	const std::string tail = "};\n\n#endif /* " + guard + " */\n";
+
+	const size_t file_size = head.size() + records_text_length(output) + tail.size();
+	Write_Status status = write_cached_file(
+		cache, file_name, key, timestamp, file_size, timestamp_begin, timestamp_end,
+		[&](char* dst) {
+			std::memcpy(dst, head.data(), head.size());
+			dst = write_records_text(dst + head.size(), output);
+			std::memcpy(dst, tail.data(), tail.size());
+		}
+	);
+	print_write_status(status, file_name);
+}
+
+template<typename T>
+void export_table_binary(
+	const Test_Gen<T>& table,
+	const Record_Columns& input,
+	const Record_Columns& output,
+	uint64_t seed,
+	Table_Cache* cache,
+	uint64_t key
+) {
+	const Binary_Table binary = {
+		table_prefix(table), static_cast<uint32_t>(float_name<T>::type_bits), seed,
+		get_ISO8601Timestamp(), table.input_layout, table.output_layout, input, output
+	};
+	print_write_status(export_binary_table(binary, cache, key), binary.prefix + ".bin");
+	print_write_status(
+		export_binary_loader(binary, table.headers, cache, key), binary.prefix + "_bin.h"
+	);
+}
+
+template<typename T>
+void export_table_encoded(
+	const Test_Gen<T>& table,
+	const Record_Columns& input,
+	const Record_Columns& output,
+	Table_Cache* cache,
+	uint64_t key
+) {
+	const Encoded_Table encoded = {
+		table_prefix(table), table.headers, get_ISO8601Timestamp(),
+		table.input_layout, table.output_layout, input, output
+	};
+	export_encoded_table(encoded, cache, key);
+}
+
+template<typename T>
+void export_table_driver(const Test_Gen<T>& table, Table_Cache* cache) {
+	if (table.driver_calls.empty()) {
+		return;
+	}
+	const Driver_Table driver = {
+		table_prefix(table), table_file_name(table),
+		table.input_layout, table.output_layout, table.driver_calls, table.correctly_rounded
+	};
+	export_driver(driver, cache);
+}
+
+template<typename T>
+std::vector<Test_Gen<T>> get_test_list(void) {
+	constexpr Field_Kind fT = float_kind<T>;
+	std::vector<Test_Gen<T>> Test_List;
+	auto libm = [](const char* name) {
+		return std::string(float_name<T>::libm_macro) + "(" + name + ")";
+	};
+	const std::string cast = std::string("(tg_") + float_name<T>::fX + ")";
+	/* sets the sign of result, if x, y and result are zeros, from the bits of x op y */
+	auto zero_sign = [](const char* result, const char* op) {
+		const std::string fX = float_name<T>::fX;
+		return std::string(" if (") + result + " == 0 && x == 0 && y == 0) { " + result +
+			" = tg_from_" + fX + "(tg_to_" + fX + "(x) " + op + " tg_to_" + fX + "(y)); }";
+	};
+
+	{
+		Test_List.push_back(Test_Gen<T>(
+			generate_unary_input<T>,
+			evaluate_ilogb_test<T>,
+			"ilogb_LUT",
+			{{fT}},
+			{{Field_Kind::expon}},
+			"#include <stdint.h>\n#include <limits.h>\n#include <math.h>"
+		));
+		Test_List.back().driver_calls = {
+			{"ROUTINE", libm("ilogb"), "result = ROUTINE(x);"}
+		};
+	}
+	{
+		Test_List.push_back(Test_Gen<T>(
+			generate_unary_input<T>,
+			evaluate_logb_test<T>,
+			"logb_LUT",
+			{{fT}},
+			{{fT}},
+			"#include <stdint.h>"
+		));
+		Test_List.back().driver_calls = {
+			{"ROUTINE", libm("logb"), "result = ROUTINE(x);"}
+		};
+	}
+	{
+		Test_List.push_back(Test_Gen<T>(
+			generate_unary_input<T>,
+			evaluate_frexp_test<T>,
+			"frexp_LUT",
+			{{fT}},
+			{{fT, "frac"}, {Field_Kind::expon, "expon"}},
+			"#include <stdint.h>\n#include <limits.h>\n#include <math.h>"
+		));
+		Test_List.back().driver_calls = {
+			{
+				"ROUTINE", libm("frexp"),
+				"frac = ROUTINE(x, &expon); expon = tg_classify_expon_" +
+				std::string(float_name<T>::fX) + "(x, expon);"
+			}
+		};
+	}
+	{
+		Test_List.push_back(Test_Gen<T>(
+			generate_ldexp_input<T>,
+			evaluate_ldexp_test<T>,
+			"ldexp_LUT",
+			{{fT, "value"}, {Field_Kind::int_dec, "expon"}},
+			{{fT}},
+			"#include <stdint.h>"
+		));
+		Test_List.back().edge_rows = ldexp_edge_product<T>().size();
+		Test_List.back().driver_calls = {
+			{"ROUTINE", libm("ldexp"), "result = ROUTINE(value, expon);"}
+		};
+	}
+	{
+		Test_List.push_back(Test_Gen<T>(
+			generate_nextafter_input<T>,
+			evaluate_nextafter_test<T>,
+			"nextafter_LUT",
+			{{fT, "value"}, {fT, "target"}},
+			{{fT}},
+			"#include <stdint.h>"
+		));
+		Test_List.back().edge_rows = product_size(nextafter_edge_sets<T>());
+		Test_List.back().driver_calls = {
+			{"ROUTINE", libm("nextafter"), "result = ROUTINE(value, target);"}
+		};
+	}
+	{
+		Test_List.push_back(Test_Gen<T>(
+			generate_unary_input<T>,
+			evaluate_sqrt_batched<T>,
+			"sqrt_LUT",
+			{{fT}},
+			{{fT}},
+			"#include <stdint.h>",
+			evaluate_sqrt_test<T>
+		));
+		Test_List.back().driver_calls = {
+			{"ROUTINE", libm("sqrt"), "result = ROUTINE(x);"}
+		};
+	}
+	if (float_name<T>::type_bits != 32) {
+		Test_List.push_back(Test_Gen<T>(
+			generate_unary_input<T>,
+			evaluate_float_to_f32_batched<T>,
+			"to_f32_LUT",
+			{{fT}},
+			{{Field_Kind::f32}},
+			"#include <stdint.h>",
+			evaluate_float_to_f32_test<T>
+		));
+		Test_List.back().driver_calls = {
+			{"ROUTINE", "(tg_f32)", "result = ROUTINE(x);"}
+		};
+	}
+	if (float_name<T>::type_bits != 64) {
+		Test_List.push_back(Test_Gen<T>(
+			generate_unary_input<T>,
+			evaluate_float_to_f64_batched<T>,
+			"to_f64_LUT",
+			{{fT}},
+			{{Field_Kind::f64}},
+			"#include <stdint.h>",
+			evaluate_float_to_f64_test<T>
+		));
+		Test_List.back().driver_calls = {
+			{"ROUTINE", "(tg_f64)", "result = ROUTINE(x);"}
+		};
+	}
+	{
+		Test_List.push_back(Test_Gen<T>(
+			generate_fma_input<T>,
+			evaluate_fma_test<T>,
+			"fma_LUT",
+			{{fT, "x"}, {fT, "y"}, {fT, "z"}},
+			{{fT}},
+			"#include <stdint.h>"
+		));
+		Test_List.back().edge_rows = product_size(fma_edge_sets<T>());
+		Test_List.back().driver_calls = {
+			{"ROUTINE", libm("fma"), "result = ROUTINE(x, y, z);"}
+		};
+	}
+	{
+		Test_List.push_back(Test_Gen<T>(
+			generate_unary_input<T>,
+			evaluate_modf_batched<T>,
+			"modf_LUT",
+			{{fT}},
+			{{fT, "frac_part"}, {fT, "trunc_part"}},
+			"#include <stdint.h>",
+			evaluate_modf_test<T>
+		));
+		Test_List.back().driver_calls = {
+			{"ROUTINE", libm("modf"), "frac_part = ROUTINE(x, &trunc_part);"}
+		};
+	}
+	{
+		Test_List.push_back(Test_Gen<T>(
+			generate_unary_input<T>,
+			evaluate_rounding_batched<T>,
+			"rounding_LUT",
+			{{fT}},
+			{{fT, "r_floor"}, {fT, "r_ceil"}, {fT, "r_round"}},
+			"#include <stdint.h>",
+			evaluate_rounding_test<T>
+		));
+		Test_List.back().driver_calls = {
+			{"FLOOR", libm("floor"), "r_floor = ROUTINE(x);"},
+			{"CEIL", libm("ceil"), "r_ceil = ROUTINE(x);"},
+			{"ROUND", libm("round"), "r_round = ROUTINE(x);"},
+		};
+	}
+	{
+		Test_List.push_back(Test_Gen<T>(
+			generate_float_to_integer_input<T>,
+			evaluate_float_to_integer_batched<T>,
+			"to_integer_LUT",
+			{{fT}},
+			{
+				{Field_Kind::u32, "u32"}, {Field_Kind::i32, "i32"},
+				{Field_Kind::u64, "u64"}, {Field_Kind::i64, "i64"}
+			},
+			"#include <stdint.h>",
+			evaluate_float_to_integer_test<T>
+		));
+		Test_List.back().driver_calls = {
+			{"U32", "(uint32_t)", "u32 = ROUTINE(x);"},
+			{"I32", "(int32_t)", "i32 = ROUTINE(x);"},
+			{"U64", "(uint64_t)", "u64 = ROUTINE(x);"},
+			{"I64", "(int64_t)", "i64 = ROUTINE(x);"},
+		};
+	}
+	{
+		Test_List.push_back(Test_Gen<T>(
+			generate_float_from_integer_input<T>,
+			evaluate_float_from_integer_batched<T>,
+			"from_integer_LUT",
+			{{Field_Kind::u32, "u32"}, {Field_Kind::u64, "u64"}},
+			{{fT, "fu32"}, {fT, "fi32"}, {fT, "fu64"}, {fT, "fi64"}},
+			"#include <stdint.h>",
+			evaluate_float_from_integer_test<T>
+		));
+		Test_List.back().driver_calls = {
+			{"FU32", cast, "fu32 = ROUTINE(u32);"},
+			{"FI32", cast, "fi32 = ROUTINE((int32_t)u32);"},
+			{"FU64", cast, "fu64 = ROUTINE(u64);"},
+			{"FI64", cast, "fi64 = ROUTINE((int64_t)u64);"},
+		};
+	}
+	for (size_t f = 0; f < oracle_functions.size(); f++) {
+		const Oracle_Function<1>& function = oracle_functions[f];
+		Test_List.push_back(Test_Gen<T>(
+			generate_unary_input<T>,
+			correctly_rounded_evaluator<T>[f],
+			(std::string(function.name) + "_LUT").c_str(),
+			{{fT}},
+			{{fT}},
+			"#include <stdint.h>"
+		));
+		Test_List.back().driver_calls = {
+			{"ROUTINE", libm(function.name), "result = ROUTINE(x);"}
+		};
+		Test_List.back().correctly_rounded = true;
+	}
+	for (size_t f = 0; f < oracle_binary_functions.size(); f++) {
+		const Oracle_Function<2>& function = oracle_binary_functions[f];
+		const std::string name = function.name;
+		Test_List.push_back(Test_Gen<T>(
+			(name == "pow") ? generate_pow_input<T> : generate_binary_input<T>,
+			correctly_rounded_binary_evaluator<T>[f],
+			(name + "_LUT").c_str(),
+			{{fT, "x"}, {fT, "y"}},
+			{{fT}},
+			"#include <stdint.h>"
+		));
+		Test_List.back().edge_rows = product_size(binary_edge_sets<T>());
+		Test_List.back().driver_calls = {
+			{"ROUTINE", libm(function.name), "result = ROUTINE(x, y);"}
+		};
+		Test_List.back().correctly_rounded = true;
+	}
+	{
+		const std::array<std::pair<const char*, Evaluate_Function>, 3> exact_functions = {{
+			{"fmod", evaluate_fmod_test<T>},
+			{"remainder", evaluate_remainder_test<T>},
+			{"copysign", evaluate_copysign_test<T>},
+		}};
+		for (const auto& [name, evaluate] : exact_functions) {
+			Test_List.push_back(Test_Gen<T>(
+				generate_binary_input<T>,
+				evaluate,
+				(std::string(name) + "_LUT").c_str(),
+				{{fT, "x"}, {fT, "y"}},
+				{{fT}},
+				"#include <stdint.h>"
+			));
+			Test_List.back().edge_rows = product_size(binary_edge_sets<T>());
+			Test_List.back().driver_calls = {
+				{"ROUTINE", libm(name), "result = ROUTINE(x, y);"}
+			};
+		}
+	}
+	{
+		Test_List.push_back(Test_Gen<T>(
+			generate_binary_input<T>,
+			evaluate_remquo_test<T>,
+			"remquo_LUT",
+			{{fT, "x"}, {fT, "y"}},
+			{{fT, "rem"}, {Field_Kind::int_dec, "quo"}},
+			"#include <stdint.h>"
+		));
+		Test_List.back().edge_rows = product_size(binary_edge_sets<T>());
+		Test_List.back().driver_calls = {
+			{
+				"ROUTINE", libm("remquo"),
+				"rem = ROUTINE(x, y, &quo); quo = (rem != rem) ? 0 : quo % 8;"
+			}
+		};
+	}
+	{
+		Test_List.push_back(Test_Gen<T>(
+			generate_binary_input<T>,
+			evaluate_fmin_fmax_test<T>,
+			"fmin_fmax_LUT",
+			{{fT, "x"}, {fT, "y"}},
+			{{fT, "r_fmin"}, {fT, "r_fmax"}},
+			"#include <stdint.h>"
+		));
+		Test_List.back().edge_rows = product_size(binary_edge_sets<T>());
+		Test_List.back().driver_calls = {
+			/* either zero is accepted for -0 and +0, which C leaves unspecified */
+			{"FMIN", libm("fmin"), "r_fmin = ROUTINE(x, y);" + zero_sign("r_fmin", "|")},
+			{"FMAX", libm("fmax"), "r_fmax = ROUTINE(x, y);" + zero_sign("r_fmax", "&")},
+		};
+	}
+	{
+		/*
+		** the operations whose results depend on the rounding mode, and rounding,
+		** whose results must not
+		*/
+		using Mode_Table = std::tuple<const char*, Evaluate_Function, Evaluate_Function>;
+		const std::array<Mode_Table, 6> modes = {{
+			{
+				"sqrt_LUT", evaluate_rounding_modes<evaluate_sqrt_batched<T>>,
+				evaluate_rounding_modes<evaluate_sqrt_test<T>>
+			},
+			{"fma_LUT", evaluate_rounding_modes<evaluate_fma_test<T>>, nullptr},
+			{"ldexp_LUT", evaluate_rounding_modes<evaluate_ldexp_test<T>>, nullptr},
+			{
+				"to_f32_LUT", evaluate_rounding_modes<evaluate_float_to_f32_batched<T>>,
+				evaluate_rounding_modes<evaluate_float_to_f32_test<T>>
+			},
+			{
+				"from_integer_LUT", evaluate_rounding_modes<evaluate_float_from_integer_batched<T>>,
+				evaluate_rounding_modes<evaluate_float_from_integer_test<T>>
+			},
+			{
+				"rounding_LUT", evaluate_rounding_modes<evaluate_rounding_batched<T>>,
+				evaluate_rounding_modes<evaluate_rounding_test<T>>
+			},
+		}};
+		const size_t table_count = Test_List.size();
+		for (const auto& [name, evaluate, reference] : modes) {
+			for (size_t t = 0; t < table_count; t++) {
+				if (Test_List[t].table_name != name) {
+					continue;
+				}
+				/* such as sqrt_modes_LUT, with the fields nearest, upward, and so on */
+				Test_Gen<T> table = Test_List[t];
+				table.table_name.insert(table.table_name.size() - 4, "_modes");
+				table.variant = Table_Variant::modes;
+				table.output_layout = rounding_mode_layout(table.output_layout);
+				table.evaluate = evaluate;
+				table.reference = reference;
+				table.driver_calls.clear();
+				Test_List.push_back(table);
+			}
+		}
+	}
+	{
+		/*
+		** the tables whose scalar evaluators perform the operation itself in T,
+		** so that the exceptions raised are those of the operation. The
+		** correctly rounded tables evaluate in wider formats, and to_integer
+		** converts out of range values
+		*/
+		const std::array<std::pair<const char*, Evaluate_Function>, 16> flag_tables = {{
+			{"ilogb_LUT", evaluate_exception_flags<evaluate_ilogb_test<T>>},
+			{"logb_LUT", evaluate_exception_flags<evaluate_logb_test<T>>},
+			{"frexp_LUT", evaluate_exception_flags<evaluate_frexp_test<T>>},
+			{"ldexp_LUT", evaluate_exception_flags<evaluate_ldexp_test<T>>},
+			{"nextafter_LUT", evaluate_exception_flags<evaluate_nextafter_test<T>>},
+			{"sqrt_LUT", evaluate_exception_flags<evaluate_sqrt_test<T>>},
+			{"to_f32_LUT", evaluate_exception_flags<evaluate_float_to_f32_test<T>>},
+			{"to_f64_LUT", evaluate_exception_flags<evaluate_float_to_f64_test<T>>},
+			{"fma_LUT", evaluate_exception_flags<evaluate_fma_test<T>>},
+			{"modf_LUT", evaluate_exception_flags<evaluate_modf_test<T>>},
+			{"rounding_LUT", evaluate_exception_flags<evaluate_rounding_test<T>>},
+			{"from_integer_LUT", evaluate_exception_flags<evaluate_float_from_integer_test<T>>},
+			{"fmod_LUT", evaluate_exception_flags<evaluate_fmod_test<T>>},
+			{"remainder_LUT", evaluate_exception_flags<evaluate_remainder_test<T>>},
+			{"remquo_LUT", evaluate_exception_flags<evaluate_remquo_test<T>>},
+			{"fmin_fmax_LUT", evaluate_exception_flags<evaluate_fmin_fmax_test<T>>},
+		}};
+		const size_t table_count = Test_List.size();
+		for (const auto& [name, evaluate] : flag_tables) {
+			for (size_t t = 0; t < table_count; t++) {
+				if (Test_List[t].table_name != name) {
+					continue;
+				}
+				/* such as sqrt_flags_LUT, with the fields result and flags */
+				Test_Gen<T> table = Test_List[t];
+				table.table_name.insert(table.table_name.size() - 4, "_flags");
+				table.variant = Table_Variant::flags;
+				table.output_layout = exception_flag_layout(table.output_layout);
+				table.headers += std::string("\n") + exception_flag_macros;
+				table.evaluate = evaluate;
+				table.reference = nullptr;
+				table.driver_calls.clear();
+				Test_List.push_back(table);
+			}
+		}
+	}
+
+	return Test_List;
+}
+
+#endif /* TEST_LIST_H */
@@ -0,0 +1,277 @@
+#ifndef VECTOR_KERNELS_H
+#define VECTOR_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#ifdef __AVX2__
+	#include <immintrin.h>
+#endif
+
+#include "table_columns.hpp"
+
+/*
+** Batched evaluation of the operations that have exact vector
+** equivalents. A kernel processes element groups of vector_lanes<T> and
+** returns how many elements it completed, stopping at the tail or at the
+** first group it cannot handle exactly (such as out of range integer
+** conversions). evaluate_batched then runs the scalar evaluator over that
+** group and resumes the kernel after it, so the results are bitwise
+** identical to the scalar evaluators, which --check-vector verifies.
+**
+** None of these operations round more than once, so libmvec, which only
+** provides approximated transcendentals, is not needed here.
+*/
+
+template<typename T>
+constexpr size_t vector_lanes = 32 / sizeof(T);
+
+template<typename Kernel, typename Scalar>
+inline void evaluate_batched(size_t begin, size_t end, size_t lanes, Kernel kernel, Scalar scalar) {
+	size_t i = begin;
+	while (i < end) {
+		i += kernel(i, end - i);
+		size_t next = (i + lanes < end) ? i + lanes : end;
+		if (i < next) {
+			scalar(i, next);
+		}
+		i = next;
+	}
+}
+
+#ifdef __AVX2__
+
+template<typename T>
+struct avx2_vec;
+
+template<>
+struct avx2_vec<float> {
+	using type = __m256;
+	static type load(const uint32_t* src) {
+		return _mm256_loadu_ps(reinterpret_cast<const float*>(src));
+	}
+	static void store(uint32_t* dst, type v) {
+		_mm256_storeu_ps(reinterpret_cast<float*>(dst), v);
+	}
+	static type set1(float x) { return _mm256_set1_ps(x); }
+	static type sqrt(type v) { return _mm256_sqrt_ps(v); }
+	template<int mode>
+	static type round(type v) { return _mm256_round_ps(v, mode | _MM_FROUND_NO_EXC); }
+	static type add(type a, type b) { return _mm256_add_ps(a, b); }
+	static type sub(type a, type b) { return _mm256_sub_ps(a, b); }
+	static type sign_bit() { return _mm256_set1_ps(-0.0f); }
+	static type and_not(type a, type b) { return _mm256_andnot_ps(a, b); }
+	static type bit_and(type a, type b) { return _mm256_and_ps(a, b); }
+	static type bit_or(type a, type b) { return _mm256_or_ps(a, b); }
+	static type blend(type a, type b, type mask) { return _mm256_blendv_ps(a, b, mask); }
+	static type cmp_ge(type a, type b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+	static type cmp_lt(type a, type b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+	static type cmp_eq(type a, type b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+	static bool all(type mask) { return _mm256_movemask_ps(mask) == 0xFF; }
+};
+
+template<>
+struct avx2_vec<double> {
+	using type = __m256d;
+	static type load(const uint64_t* src) {
+		return _mm256_loadu_pd(reinterpret_cast<const double*>(src));
+	}
+	static void store(uint64_t* dst, type v) {
+		_mm256_storeu_pd(reinterpret_cast<double*>(dst), v);
+	}
+	static type set1(double x) { return _mm256_set1_pd(x); }
+	static type sqrt(type v) { return _mm256_sqrt_pd(v); }
+	template<int mode>
+	static type round(type v) { return _mm256_round_pd(v, mode | _MM_FROUND_NO_EXC); }
+	static type add(type a, type b) { return _mm256_add_pd(a, b); }
+	static type sub(type a, type b) { return _mm256_sub_pd(a, b); }
+	static type sign_bit() { return _mm256_set1_pd(-0.0); }
+	static type and_not(type a, type b) { return _mm256_andnot_pd(a, b); }
+	static type bit_and(type a, type b) { return _mm256_and_pd(a, b); }
+	static type bit_or(type a, type b) { return _mm256_or_pd(a, b); }
+	static type blend(type a, type b, type mask) { return _mm256_blendv_pd(a, b, mask); }
+	static type cmp_ge(type a, type b) { return _mm256_cmp_pd(a, b, _CMP_GE_OQ); }
+	static type cmp_lt(type a, type b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+	static type cmp_eq(type a, type b) { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+	static bool all(type mask) { return _mm256_movemask_pd(mask) == 0xF; }
+};
+
+template<typename T>
+inline size_t sqrt_avx2(const float_bits<T>* x, float_bits<T>* y, size_t n) {
+	using V = avx2_vec<T>;
+	size_t i = 0;
+	for (; i + vector_lanes<T> <= n; i += vector_lanes<T>) {
+		V::store(y + i, V::sqrt(V::load(x + i)));
+	}
+	return i;
+}
+
+template<typename T>
+inline size_t rounding_avx2(
+	const float_bits<T>* x, float_bits<T>* r_floor, float_bits<T>* r_ceil, float_bits<T>* r_round,
+	size_t n
+) {
+	using V = avx2_vec<T>;
+	const typename V::type sign = V::sign_bit();
+	const typename V::type half = V::set1(static_cast<T>(0.5));
+	const typename V::type one = V::set1(static_cast<T>(1.0));
+	size_t i = 0;
+	for (; i + vector_lanes<T> <= n; i += vector_lanes<T>) {
+		typename V::type v = V::load(x + i);
+		V::store(r_floor + i, V::template round<_MM_FROUND_TO_NEG_INF>(v));
+		V::store(r_ceil + i, V::template round<_MM_FROUND_TO_POS_INF>(v));
+		/* round half away from zero: x - trunc(x) is exact */
+		typename V::type t = V::template round<_MM_FROUND_TO_ZERO>(v);
+		typename V::type frac = V::and_not(sign, V::sub(v, t));
+		typename V::type away = V::add(t, V::bit_or(one, V::bit_and(sign, v)));
+		V::store(r_round + i, V::blend(t, away, V::cmp_ge(frac, half)));
+	}
+	return i;
+}
+
+template<typename T>
+inline size_t modf_avx2(
+	const float_bits<T>* x, float_bits<T>* frac_part, float_bits<T>* trunc_part, size_t n
+) {
+	using V = avx2_vec<T>;
+	const typename V::type sign = V::sign_bit();
+	const typename V::type inf = V::set1(std::numeric_limits<T>::infinity());
+	size_t i = 0;
+	for (; i + vector_lanes<T> <= n; i += vector_lanes<T>) {
+		typename V::type v = V::load(x + i);
+		typename V::type t = V::template round<_MM_FROUND_TO_ZERO>(v);
+		typename V::type x_sign = V::bit_and(sign, v);
+		/* the fraction has the sign of x, and is zero for infinities */
+		typename V::type frac = V::bit_or(x_sign, V::and_not(sign, V::sub(v, t)));
+		frac = V::blend(frac, x_sign, V::cmp_eq(V::and_not(sign, v), inf));
+		V::store(frac_part + i, frac);
+		V::store(trunc_part + i, t);
+	}
+	return i;
+}
+
+inline size_t f32_to_f64_avx2(const uint32_t* x, uint64_t* y, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m128 v = _mm_loadu_ps(reinterpret_cast<const float*>(x + i));
+		_mm256_storeu_pd(reinterpret_cast<double*>(y + i), _mm256_cvtps_pd(v));
+	}
+	return i;
+}
+
+inline size_t f64_to_f32_avx2(const uint64_t* x, uint32_t* y, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m256d v = _mm256_loadu_pd(reinterpret_cast<const double*>(x + i));
+		_mm_storeu_ps(reinterpret_cast<float*>(y + i), _mm256_cvtpd_ps(v));
+	}
+	return i;
+}
+
+/* stores v sign extended to 64 bits */
+inline void store_i32x4_as_i64(uint64_t* dst, __m128i v) {
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), _mm256_cvtepi32_epi64(v));
+}
+
+/*
+** Only groups with every value in [-2^31, 2^31) are converted, where all
+** four conversions are the sign extended 32bit truncation (as the scalar
+** conversions compile to on x86-64). Other groups, including NaNs, are
+** left to the scalar evaluator.
+*/
+template<typename T>
+inline size_t to_integer_avx2(
+	const float_bits<T>* x, uint32_t* u32, uint32_t* i32, uint64_t* u64, uint64_t* i64, size_t n
+) {
+	using V = avx2_vec<T>;
+	const typename V::type low = V::set1(static_cast<T>(-0x1.0p+31));
+	const typename V::type high = V::set1(static_cast<T>(+0x1.0p+31));
+	size_t i = 0;
+	for (; i + vector_lanes<T> <= n; i += vector_lanes<T>) {
+		typename V::type v = V::load(x + i);
+		if (!V::all(V::bit_and(V::cmp_ge(v, low), V::cmp_lt(v, high)))) {
+			return i;
+		}
+		if constexpr (std::is_same_v<T, float>) {
+			__m256i t = _mm256_cvttps_epi32(v);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(u32 + i), t);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(i32 + i), t);
+			__m128i t_lo = _mm256_castsi256_si128(t);
+			__m128i t_hi = _mm256_extracti128_si256(t, 1);
+			store_i32x4_as_i64(u64 + i, t_lo);
+			store_i32x4_as_i64(u64 + i + 4, t_hi);
+			store_i32x4_as_i64(i64 + i, t_lo);
+			store_i32x4_as_i64(i64 + i + 4, t_hi);
+		} else {
+			__m128i t = _mm256_cvttpd_epi32(v);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(u32 + i), t);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(i32 + i), t);
+			store_i32x4_as_i64(u64 + i, t);
+			store_i32x4_as_i64(i64 + i, t);
+		}
+	}
+	return i;
+}
+
+/* exact, as both halves fit in the significand */
+inline __m256 u32_to_f32_avx2(__m256i v) {
+	__m256 hi = _mm256_cvtepi32_ps(_mm256_srli_epi32(v, 16));
+	__m256 lo = _mm256_cvtepi32_ps(_mm256_and_si256(v, _mm256_set1_epi32(0xFFFF)));
+	return _mm256_add_ps(_mm256_mul_ps(hi, _mm256_set1_ps(65536.0f)), lo);
+}
+
+/* 0 is -2^31 + 2^31, which is -0 when rounding downward, so the sign is cleared */
+inline __m256d u32_to_f64_avx2(__m128i v) {
+	__m128i biased = _mm_xor_si128(v, _mm_set1_epi32(INT32_MIN));
+	__m256d sum = _mm256_add_pd(_mm256_cvtepi32_pd(biased), _mm256_set1_pd(0x1.0p+31));
+	return _mm256_andnot_pd(_mm256_set1_pd(-0.0), sum);
+}
+
+/* hi * 2^32 + lo, where both terms are exact and the sum is the only rounding */
+template<bool is_signed>
+inline __m256d u64_to_f64_avx2(__m256i v) {
+	const __m256i split = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+	__m256i words = _mm256_permutevar8x32_epi32(v, split);
+	__m128i lo = _mm256_castsi256_si128(words);
+	__m128i hi = _mm256_extracti128_si256(words, 1);
+	__m256d hi_d = is_signed ? _mm256_cvtepi32_pd(hi) : u32_to_f64_avx2(hi);
+	return _mm256_add_pd(_mm256_mul_pd(hi_d, _mm256_set1_pd(0x1.0p+32)), u32_to_f64_avx2(lo));
+}
+
+/*
+** 64bit integers to float are rounded twice through double, so those
+** columns stay scalar for float.
+*/
+template<typename T>
+inline size_t from_integer_avx2(
+	const uint32_t* u32, const uint64_t* u64,
+	float_bits<T>* fu32, float_bits<T>* fi32, float_bits<T>* fu64, float_bits<T>* fi64,
+	size_t n
+) {
+	size_t i = 0;
+	for (; i + vector_lanes<T> <= n; i += vector_lanes<T>) {
+		if constexpr (std::is_same_v<T, float>) {
+			__m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(u32 + i));
+			_mm256_storeu_ps(reinterpret_cast<float*>(fu32 + i), u32_to_f32_avx2(v));
+			_mm256_storeu_ps(reinterpret_cast<float*>(fi32 + i), _mm256_cvtepi32_ps(v));
+			for (size_t j = i; j < i + vector_lanes<T>; j++) {
+				fu64[j] = to_bits(static_cast<float>(u64[j]));
+				fi64[j] = to_bits(static_cast<float>(static_cast<int64_t>(u64[j])));
+			}
+		} else {
+			__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(u32 + i));
+			__m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(u64 + i));
+			_mm256_storeu_pd(reinterpret_cast<double*>(fu32 + i), u32_to_f64_avx2(v));
+			_mm256_storeu_pd(reinterpret_cast<double*>(fi32 + i), _mm256_cvtepi32_pd(v));
+			_mm256_storeu_pd(reinterpret_cast<double*>(fu64 + i), u64_to_f64_avx2<false>(w));
+			_mm256_storeu_pd(reinterpret_cast<double*>(fi64 + i), u64_to_f64_avx2<true>(w));
+		}
+	}
+	return i;
+}
+
+#endif /* __AVX2__ */
+
+#endif /* VECTOR_KERNELS_H */
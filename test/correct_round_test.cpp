@@ -0,0 +1,110 @@
+/*
+**	Author: zerico2005 (2025)
+**	Project:
+**	License: MIT License
+**	A copy of the MIT License should be included with
+**	this project. If not, see https://opensource.org/license/MIT
+*/
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+#include "correct_round.h"
+#include "edge_cases.h"
+#include "table_columns.hpp"
+
+/*
+** Checks that the correctly rounded tables quiet signaling NaNs, as libm
+** does: each NaN result must be the NaN input with its quiet bit set. The
+** unary functions are evaluated over edge_cases, and the binary functions
+** over every pair of them with a NaN.
+*/
+
+template<typename T>
+constexpr float_bits<T> quiet_bit = float_bits<T>(1) << (std::numeric_limits<T>::digits - 2);
+
+template<typename T>
+inline Record_Columns edge_case_columns(size_t fields) {
+	const size_t n = edge_cases<T>.size();
+	size_t count = n;
+	for (size_t f = 1; f < fields; f++) {
+		count *= n;
+	}
+	Record_Columns input(Record_Layout{{float_kind<T>}}, count);
+	for (size_t f = 1; f < fields; f++) {
+		input.columns.emplace_back(Field{float_kind<T>}, count);
+	}
+	for (size_t i = 0; i < count; i++) {
+		size_t index = i;
+		for (size_t f = 0; f < fields; f++) {
+			input[f].template values<float_bits<T>>()[i] = to_bits(edge_cases<T>[index % n]);
+			index /= n;
+		}
+	}
+	return input;
+}
+
+/*
+** @returns the number of rows whose result is not their first signaling
+** NaN quieted, or, for unary functions, their quiet NaN
+*/
+template<typename T>
+size_t check_nan_rows(const char* name, const Record_Columns& input, const Record_Columns& output) {
+	size_t failures = 0;
+	auto result = output[0].values<float_bits<T>>();
+	for (size_t i = 0; i < input.size(); i++) {
+		bool has_nan = false;
+		float_bits<T> expected = 0;
+		for (size_t f = 0; f < input.columns.size(); f++) {
+			const float_bits<T> x = input[f].values<float_bits<T>>()[i];
+			if (is_signaling_nan(from_bits<T>(x))) {
+				has_nan = true;
+				expected = x | quiet_bit<T>;
+				break;
+			}
+			if (input.columns.size() == 1 && std::isnan(from_bits<T>(x))) {
+				has_nan = true;
+				expected = x;
+			}
+		}
+		if (has_nan && result[i] != expected) {
+			printf(
+				"Error: %s row %zu returned 0x%llX, expected the quiet NaN 0x%llX\n",
+				name, i, static_cast<unsigned long long>(result[i]),
+				static_cast<unsigned long long>(expected)
+			);
+			failures++;
+		}
+	}
+	return failures;
+}
+
+template<typename T>
+size_t check_type() {
+	size_t failures = 0;
+	const Record_Columns unary_input = edge_case_columns<T>(1);
+	for (size_t f = 0; f < oracle_functions.size(); f++) {
+		Record_Columns output(Record_Layout{{float_kind<T>}}, unary_input.size());
+		correctly_rounded_evaluator<T>[f](unary_input, output, 0, unary_input.size());
+		failures += check_nan_rows<T>(oracle_functions[f].name, unary_input, output);
+	}
+	const Record_Columns binary_input = edge_case_columns<T>(2);
+	for (size_t f = 0; f < oracle_binary_functions.size(); f++) {
+		Record_Columns output(Record_Layout{{float_kind<T>}}, binary_input.size());
+		correctly_rounded_binary_evaluator<T>[f](binary_input, output, 0, binary_input.size());
+		failures += check_nan_rows<T>(oracle_binary_functions[f].name, binary_input, output);
+	}
+	return failures;
+}
+
+int main() {
+	size_t failures = check_type<float>() + check_type<double>();
+	if (failures != 0) {
+		printf("%zu checks failed\n", failures);
+		return 1;
+	}
+	printf("correct_round: all checks passed\n");
+	return 0;
+}
@@ -0,0 +1,204 @@
+/*
+**	Author: zerico2005 (2025)
+**	Project:
+**	License: MIT License
+**	A copy of the MIT License should be included with
+**	this project. If not, see https://opensource.org/license/MIT
+*/
+
+#include <bit>
+#include <cinttypes>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "export_value.h"
+#include "hex_encode.h"
+#include "table_columns.hpp"
+
+/*
+** Checks encode_hex_literals and encode_hex_literal byte for byte against
+** export_value and export_field, for every field kind exported in hex, and
+** export_value against the snprintf formatting it replaced. The counts cover
+** an empty batch, the scalar tail alone, and the AVX2 body with and without
+** a tail, both packed and written into wider rows.
+*/
+
+constexpr size_t test_counts[] = {0, 1, 7, 8, 9, 33};
+
+/* NaN, infinity and negative zero of both formats, and bytes of every value */
+constexpr uint64_t test_patterns[] = {
+	0x7FC00000, 0x7FA00001, 0xFFC00000, 0x7F800000, 0xFF800000, 0x80000000,
+	UINT64_C(0x7FF8000000000000), UINT64_C(0x7FF4000000000001), UINT64_C(0xFFF8000000000000),
+	UINT64_C(0x7FF0000000000000), UINT64_C(0xFFF0000000000000), UINT64_C(0x8000000000000000),
+	0, 1, UINT64_C(0x0123456789ABCDEF), UINT64_C(0xFEDCBA9876543210), UINT64_MAX,
+};
+
+constexpr Field_Kind hex_kinds[] = {
+	Field_Kind::f32, Field_Kind::u32, Field_Kind::i32,
+	Field_Kind::f64, Field_Kind::u64, Field_Kind::i64,
+};
+
+inline const char* kind_name(Field_Kind kind) {
+	switch (kind) {
+		case Field_Kind::f32: return "f32";
+		case Field_Kind::u32: return "u32";
+		case Field_Kind::i32: return "i32";
+		case Field_Kind::f64: return "f64";
+		case Field_Kind::u64: return "u64";
+		case Field_Kind::i64: return "i64";
+		default: return "decimal";
+	}
+}
+
+/* a column of count values, starting with test_patterns truncated to the field */
+inline Column test_column(Field_Kind kind, size_t count) {
+	Column column({kind}, count);
+	uint64_t state = UINT64_C(0x9E3779B97F4A7C15);
+	const size_t pattern_count = sizeof(test_patterns) / sizeof(test_patterns[0]);
+	for (size_t i = 0; i < count; i++) {
+		state = state * UINT64_C(6364136223846793005) + UINT64_C(1442695040888963407);
+		const uint64_t value = (i < pattern_count) ? test_patterns[i] : state;
+		if (field_is_wide(kind)) {
+			column.values<uint64_t>()[i] = value;
+		} else {
+			column.values<uint32_t>()[i] = static_cast<uint32_t>(value);
+		}
+	}
+	return column;
+}
+
+/* export_value of the C type the field holds */
+inline std::string typed_export_value(Field_Kind kind, uint64_t raw) {
+	switch (kind) {
+		case Field_Kind::f32: return export_value(std::bit_cast<float>(static_cast<uint32_t>(raw)));
+		case Field_Kind::u32: return export_value(static_cast<uint32_t>(raw));
+		case Field_Kind::i32: return export_value(static_cast<int32_t>(raw));
+		case Field_Kind::f64: return export_value(std::bit_cast<double>(raw));
+		case Field_Kind::u64: return export_value(raw);
+		case Field_Kind::i64: return export_value(static_cast<int64_t>(raw));
+		default: return "";
+	}
+}
+
+/* the snprintf formatting of export_value before the batch encoder */
+inline std::string snprintf_literal(Field_Kind kind, uint64_t raw) {
+	char buf[256];
+	const char* macro = field_literal_macro(kind);
+	if (field_is_wide(kind)) {
+		snprintf(buf, sizeof(buf), "%s(0x%016" PRIX64 ")", macro, raw);
+	} else {
+		snprintf(buf, sizeof(buf), "%s(0x%08" PRIX32 ")", macro, static_cast<uint32_t>(raw));
+	}
+	return buf;
+}
+
+/* the rows of column encoded at stride, as table_writer.h encodes them */
+inline size_t encode_column(const Column& column, char* dst, size_t stride) {
+	const char* macro = field_literal_macro(column.field.kind);
+	if (field_is_wide(column.field.kind)) {
+		return encode_hex_literals(column.values<uint64_t>(), macro, dst, stride);
+	}
+	return encode_hex_literals(column.values<uint32_t>(), macro, dst, stride);
+}
+
+/* the int32_t overload of encode_hex_literals */
+inline size_t encode_column_i32(const Column& column, char* dst, size_t stride) {
+	std::span<const uint32_t> values = column.values<uint32_t>();
+	std::vector<int32_t> signed_values(values.size());
+	for (size_t i = 0; i < values.size(); i++) {
+		signed_values[i] = static_cast<int32_t>(values[i]);
+	}
+	return encode_hex_literals(
+		std::span<const int32_t>(signed_values), field_literal_macro(column.field.kind),
+		dst, stride
+	);
+}
+
+/* @returns the number of mismatches */
+inline size_t check_batch(
+	const Column& column, const std::vector<std::string>& expected_rows, size_t stride,
+	size_t (*encode)(const Column&, char*, size_t), const char* encoder
+) {
+	const size_t count = expected_rows.size();
+	const size_t length = hex_literal_length(
+		field_literal_macro(column.field.kind), field_hex_digits(column.field.kind)
+	);
+	std::string expected(count * stride, '.');
+	for (size_t i = 0; i < count; i++) {
+		expected.replace(i * stride, expected_rows[i].size(), expected_rows[i]);
+	}
+	std::string encoded(count * stride, '.');
+	const size_t end = encode(column, encoded.data(), stride);
+	const size_t expected_end = (count == 0) ? 0 : (count - 1) * stride + length;
+	if (encoded != expected || end != expected_end) {
+		printf(
+			"Error: %s of %s differs from export_value for %zu values, stride %zu\n",
+			encoder, kind_name(column.field.kind), count, stride
+		);
+		return 1;
+	}
+	return 0;
+}
+
+/* @returns the number of mismatches */
+inline size_t check_kind(Field_Kind kind) {
+	size_t failures = 0;
+	const char* macro = field_literal_macro(kind);
+	const size_t length = hex_literal_length(macro, field_hex_digits(kind));
+	for (size_t count : test_counts) {
+		const Column column = test_column(kind, count);
+		std::vector<std::string> expected_rows(count);
+		for (size_t i = 0; i < count; i++) {
+			const uint64_t raw = column.raw(i);
+			expected_rows[i] = typed_export_value(kind, raw);
+			if (expected_rows[i] != snprintf_literal(kind, raw)) {
+				printf("Error: export_value of %s differs from snprintf\n", kind_name(kind));
+				failures++;
+			}
+			if (export_field(column, i) != expected_rows[i]) {
+				printf("Error: export_field of %s differs from export_value\n", kind_name(kind));
+				failures++;
+			}
+			char buf[64];
+			char* end = field_is_wide(kind) ?
+				encode_hex_literal(buf, raw, macro) :
+				encode_hex_literal(buf, static_cast<uint32_t>(raw), macro);
+			if (std::string(buf, static_cast<size_t>(end - buf)) != expected_rows[i]) {
+				printf(
+					"Error: encode_hex_literal of %s differs from export_value\n", kind_name(kind)
+				);
+				failures++;
+			}
+		}
+		for (size_t stride : {length, length + 5}) {
+			failures += check_batch(
+				column, expected_rows, stride, encode_column, "encode_hex_literals"
+			);
+			if (kind == Field_Kind::i32) {
+				failures += check_batch(
+					column, expected_rows, stride, encode_column_i32,
+					"encode_hex_literals(int32_t)"
+				);
+			}
+		}
+	}
+	return failures;
+}
+
+int main() {
+	size_t failures = 0;
+	for (Field_Kind kind : hex_kinds) {
+		failures += check_kind(kind);
+	}
+	if (failures != 0) {
+		printf("%zu checks failed\n", failures);
+		return 1;
+	}
+	printf("hex_encode: all checks passed\n");
+	return 0;
+}
@@ -0,0 +1,55 @@
+# Generates the C driver of every table, then builds and runs each against
+# the host libm. f64 is taken to be double, and the correctly rounded
+# tables accept the errors of a faithfully rounded libm.
+# Expects TEST_GEN, C_COMPILER and OUTPUT_DIR.
+set(MAX_ULPS 4)
+
+file(REMOVE_RECURSE "${OUTPUT_DIR}")
+file(MAKE_DIRECTORY "${OUTPUT_DIR}")
+execute_process(
+	COMMAND "${TEST_GEN}" --force --format driver -o "${OUTPUT_DIR}"
+	RESULT_VARIABLE result
+	OUTPUT_QUIET
+)
+if(NOT result EQUAL 0)
+	message(FATAL_ERROR "Test_Gen --format driver failed: ${result}")
+endif()
+
+file(GLOB drivers "${OUTPUT_DIR}/*_driver.c")
+list(LENGTH drivers driver_count)
+if(driver_count EQUAL 0)
+	message(FATAL_ERROR "no drivers were generated")
+endif()
+set(failures "")
+foreach(driver ${drivers})
+	get_filename_component(name "${driver}" NAME_WE)
+	set(program "${OUTPUT_DIR}/${name}")
+	execute_process(
+		COMMAND "${C_COMPILER}" -std=c11 -O2 -Wall -Wextra
+			-DTEST_GEN_ANY_NAN -DTEST_GEN_MAX_ULPS=${MAX_ULPS}
+			-DTEST_GEN_F64_TYPE=double "-DTEST_GEN_F64_LIBM(name)=name"
+			"${driver}" -o "${program}" -lm
+		RESULT_VARIABLE result
+		ERROR_VARIABLE errors
+	)
+	if(NOT result EQUAL 0)
+		message(STATUS "${name}: does not build\n${errors}")
+		list(APPEND failures "${name}")
+		continue()
+	endif()
+	execute_process(
+		COMMAND "${program}"
+		RESULT_VARIABLE result
+		OUTPUT_VARIABLE output
+	)
+	if(NOT result EQUAL 0)
+		message(STATUS "${name}: failed\n${output}")
+		list(APPEND failures "${name}")
+	endif()
+endforeach()
+
+list(LENGTH failures failure_count)
+if(NOT failure_count EQUAL 0)
+	message(FATAL_ERROR "${failure_count} of ${driver_count} drivers failed: ${failures}")
+endif()
+message(STATUS "all ${driver_count} drivers passed")